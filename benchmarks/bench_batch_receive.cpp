@@ -0,0 +1,137 @@
+#include "bench_utility.hpp"
+#include "uart_protocol/protocol.hpp"
+
+/*
+ * Batch Receive Benchmark
+ *
+ * Frames/s when the driver delivers bursts of 1, 16 and 256 back-to-back frames (8-byte payload,
+ * handed out in 64-byte receive_data() chunks):
+ *  - per-frame: the parse_frame() loop with one erase per frame (the old wait_ack / example receiver pattern)
+ *  - batch:     BasicProtocol::receive_frames(), one decode pass and one compaction per call
+ */
+
+using namespace uart_protocol;
+using namespace uart_protocol::bench;
+
+namespace
+{
+    constexpr size_t PAYLOAD_SIZE = 8;
+    constexpr size_t CHUNK_SIZE = 64;
+
+    // Replays the same burst of frames every time it is re-armed
+    class BurstUart : public Uart
+    {
+    private:
+        std::vector<uint8_t> burst_;
+        size_t head_ = 0;
+
+    public:
+        explicit BurstUart(size_t frames)
+        {
+            uint8_t payload[PAYLOAD_SIZE] = {0xDE, 0xAD, 0xBE, 0xEF, 0x01, 0x02, 0x03, 0x04};
+            uint8_t raw[MAX_FRAME_SIZE];
+            for (size_t i = 0; i < frames; ++i)
+            {
+                payload[0] = static_cast<uint8_t>(i);
+                size_t size = encode_frame(config::DATA_TYPE, payload, sizeof(payload), raw);
+                burst_.insert(burst_.end(), raw, raw + size);
+            }
+            head_ = burst_.size();
+        }
+
+        bool init() override { return true; }
+        void deinit() override {}
+        bool send_data(const uint8_t *, size_t) override { return true; }
+
+        size_t receive_data(uint8_t *out_buffer, size_t max_bytes) override
+        {
+            size_t n = burst_.size() - head_;
+            n = n < max_bytes ? n : max_bytes;
+            n = n < CHUNK_SIZE ? n : CHUNK_SIZE;
+            std::memcpy(out_buffer, burst_.data() + head_, n);
+            head_ += n;
+            return n;
+        }
+
+        void rearm() { head_ = 0; }
+    };
+
+    double run_per_frame(size_t frames, size_t iterations)
+    {
+        BurstUart uart(frames);
+        std::vector<uint8_t> recv_buffer;
+        recv_buffer.reserve(config::MAX_PAYLOAD_SIZE + 10);
+        uint8_t temp_buffer[CHUNK_SIZE];
+        size_t received = 0;
+
+        double ns = measure_ns(iterations, [&]
+                               {
+            uart.rearm();
+            size_t n;
+            while ((n = uart.receive_data(temp_buffer, sizeof(temp_buffer))) > 0)
+            {
+                recv_buffer.insert(recv_buffer.end(), temp_buffer, temp_buffer + n);
+                Frame frame;
+                size_t consumed = 0;
+                while (parse_frame(recv_buffer, frame, consumed))
+                {
+                    recv_buffer.erase(recv_buffer.begin(), recv_buffer.begin() + consumed);
+                    do_not_optimize(frame.payload.data());
+                    ++received;
+                }
+            } });
+        if (received != frames * iterations)
+        {
+            std::printf("per-frame: lost frames (%zu of %zu)\n", received, frames * iterations);
+        }
+        return ns;
+    }
+
+    double run_batch(size_t frames, size_t iterations)
+    {
+        BurstUart uart(frames);
+        BasicProtocol<Uart> protocol(uart);
+        FrameView views[256];
+        size_t received = 0;
+
+        double ns = measure_ns(iterations, [&]
+                               {
+            uart.rearm();
+            size_t count;
+            while ((count = protocol.receive_frames(views, sizeof(views) / sizeof(views[0]))) > 0)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    do_not_optimize(views[i].payload);
+                }
+                received += count;
+            } });
+        if (received != frames * iterations)
+        {
+            std::printf("batch: lost frames (%zu of %zu)\n", received, frames * iterations);
+        }
+        return ns;
+    }
+
+    void print_rate(const char *name, size_t frames, double ns_per_burst)
+    {
+        double frames_per_s = static_cast<double>(frames) * 1e9 / ns_per_burst;
+        std::printf("%-30s %8zu %14.0f %14.1f\n", name, frames, frames_per_s, ns_per_burst / static_cast<double>(frames));
+    }
+} // namespace
+
+int main()
+{
+    constexpr size_t total_frames = 1 << 20;
+    const size_t bursts[] = {1, 16, 256};
+
+    std::printf("\n=== Batch receive: %zu-byte payload, %zu-byte driver chunks ===\n", PAYLOAD_SIZE, CHUNK_SIZE);
+    std::printf("%-30s %8s %14s %14s\n", "benchmark", "burst", "frames/s", "ns/frame");
+    for (size_t frames : bursts)
+    {
+        size_t iterations = total_frames / frames;
+        print_rate("per-frame parse_frame + erase", frames, run_per_frame(frames, iterations));
+        print_rate("batch receive_frames", frames, run_batch(frames, iterations));
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "bench_utility.hpp"
+#include "uart_protocol/capture.hpp"
+#include "uart_protocol/replay.hpp"
+#include "porting/posix/mapped_file.hpp"
+#include <random>
+#include <string>
+
+/*
+ * Capture Replay Benchmark
+ *
+ * Usage: bench_capture_replay [capture.upcap]
+ *
+ * Without an argument a synthetic capture (random frames, line noise, random chunk sizes) is written
+ * to a temporary file first. The capture is memory-mapped and its RX direction is replayed through:
+ *  - StreamChunkDecoder (zero-copy decode_frame)
+ *  - ParseFrameDecoder  (std::vector based parse_frame loop)
+ * and finally through a ReplayUart at high speed to check the timed path decodes the same frames.
+ */
+
+using namespace uart_protocol;
+using namespace uart_protocol::capture;
+
+namespace
+{
+    // Write ~`target_bytes` of RX traffic in driver-sized chunks
+    bool write_synthetic_capture(const char *path, size_t target_bytes)
+    {
+        CaptureWriter writer;
+        if (!writer.open(path))
+        {
+            return false;
+        }
+
+        std::mt19937 rng(7);
+        std::vector<uint8_t> stream;
+        stream.reserve(1 << 16);
+        uint64_t timestamp_us = 0;
+        uint8_t payload[MAX_FRAME_SIZE];
+        uint8_t frame[MAX_FRAME_SIZE];
+        size_t total = 0;
+
+        while (total < target_bytes)
+        {
+            if (rng() % 50 == 0)
+            {
+                stream.push_back(static_cast<uint8_t>(rng())); // line noise
+            }
+            size_t len = rng() % 64;
+            for (size_t i = 0; i < len; ++i)
+            {
+                payload[i] = static_cast<uint8_t>(rng());
+            }
+            size_t frame_size = encode_frame(config::DATA_TYPE, payload, len, frame);
+            stream.insert(stream.end(), frame, frame + frame_size);
+
+            if (stream.size() >= 4096)
+            {
+                size_t offset = 0;
+                while (offset < stream.size())
+                {
+                    size_t chunk = 1 + rng() % 512;
+                    chunk = chunk < stream.size() - offset ? chunk : stream.size() - offset;
+                    timestamp_us += chunk * 10; // ~1 Mbaud
+                    writer.write(Direction::Rx, stream.data() + offset, chunk, timestamp_us);
+                    offset += chunk;
+                }
+                total += stream.size();
+                stream.clear();
+            }
+        }
+        writer.close();
+        return true;
+    }
+
+    void print_stats(const char *name, const ReplayStats &stats)
+    {
+        std::printf("%-28s %12llu frames %10.2f MB %12.0f frames/s %8.3f GB/s\n", name,
+                    static_cast<unsigned long long>(stats.frames), static_cast<double>(stats.bytes) / 1e6,
+                    stats.frames_per_second(), stats.gigabytes_per_second());
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string path = argc > 1 ? argv[1] : "/tmp/uart_protocol_bench.upcap";
+    if (argc <= 1 && !write_synthetic_capture(path.c_str(), 64u << 20))
+    {
+        std::fprintf(stderr, "Cannot write %s\n", path.c_str());
+        return 1;
+    }
+
+    MappedFile file;
+    if (!file.open(path.c_str()))
+    {
+        std::fprintf(stderr, "Cannot map %s\n", path.c_str());
+        return 1;
+    }
+    CaptureReader reader(file.data(), file.size());
+    if (!reader.valid())
+    {
+        std::fprintf(stderr, "%s is not a capture file\n", path.c_str());
+        return 1;
+    }
+
+    std::printf("\n=== Capture replay: %s (%.2f MB) ===\n", path.c_str(), static_cast<double>(file.size()) / 1e6);
+    print_stats("StreamChunkDecoder", replay_decode(reader, Direction::Rx, StreamChunkDecoder{}));
+    print_stats("ParseFrameDecoder", replay_decode(reader, Direction::Rx, ParseFrameDecoder{}));
+
+    // Timed replay through a Uart (sped up so the benchmark finishes quickly)
+    ReplayUart replay(reader, Direction::Rx, 1e6);
+    replay.init();
+    StreamDecoder decoder;
+    uint8_t buffer[4096];
+    auto start = bench::bench_clock::now();
+    while (!replay.finished())
+    {
+        size_t n = replay.receive_data(buffer, sizeof(buffer));
+        decoder.feed(buffer, n, [](const FrameView &) {});
+    }
+    double seconds = std::chrono::duration<double>(bench::bench_clock::now() - start).count();
+    std::printf("%-28s %12llu frames %10.2f s\n", "ReplayUart (x1e6 speed)",
+                static_cast<unsigned long long>(decoder.frames()), seconds);
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "bench_utility.hpp"
+#include "uart_protocol/mpsc_frame_queue.hpp"
+#include "uart_protocol/protocol.hpp"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+/*
+ * Concurrent Send Benchmark
+ *
+ * N producer threads send 16-byte DATA frames through one link:
+ *  - mutex:   BasicProtocol<Uart> guarded by a std::mutex (every producer writes under the lock)
+ *  - mpsc:    BasicProtocol<ConcurrentSendUart> (lock-free enqueue, one drainer thread writes)
+ * The driver only counts bytes. Reports frames/s over all producers for 1..32 threads.
+ */
+
+using namespace uart_protocol;
+using namespace uart_protocol::bench;
+
+namespace
+{
+    constexpr size_t FRAMES_TOTAL = 400000;
+
+    class CountingUart : public Uart
+    {
+    public:
+        uint64_t bytes = 0;
+        uint64_t writes = 0;
+
+        bool init() override { return true; }
+        void deinit() override {}
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            do_not_optimize(data);
+            bytes += size;
+            ++writes;
+            return true;
+        }
+        size_t receive_data(uint8_t *, size_t) override { return 0; }
+    };
+
+    template <typename Fn>
+    double run_producers(unsigned producers, Fn &&send_one)
+    {
+        std::atomic<bool> go{false};
+        std::vector<std::thread> threads;
+        size_t per_thread = FRAMES_TOTAL / producers;
+        for (unsigned t = 0; t < producers; ++t)
+        {
+            threads.emplace_back([&, t]
+                                 {
+                uint8_t payload[16] = {static_cast<uint8_t>(t)};
+                while (!go.load(std::memory_order_acquire))
+                {
+                }
+                for (size_t i = 0; i < per_thread; ++i)
+                {
+                    send_one(payload, sizeof(payload));
+                } });
+        }
+        auto start = bench_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(bench_clock::now() - start).count();
+        return static_cast<double>(per_thread * producers) / seconds;
+    }
+} // namespace
+
+int main()
+{
+    std::printf("\n=== Concurrent send: %zu frames, %u hardware threads ===\n", FRAMES_TOTAL, std::thread::hardware_concurrency());
+    std::printf("%-10s %18s %18s\n", "producers", "mutex frames/s", "mpsc frames/s");
+
+    for (unsigned producers : {1u, 2u, 4u, 8u, 16u, 32u})
+    {
+        // Baseline: shared protocol behind a mutex
+        CountingUart mutex_uart;
+        Protocol mutex_protocol(mutex_uart);
+        std::mutex mutex;
+        double mutex_rate = run_producers(producers, [&](const uint8_t *payload, size_t len)
+                                          {
+            std::lock_guard<std::mutex> lock(mutex);
+            mutex_protocol.send_frame(config::DATA_TYPE, payload, len); });
+
+        // Lock-free queue with a dedicated drainer
+        CountingUart mpsc_uart;
+        ConcurrentSendUart<CountingUart, 1024> tx(mpsc_uart);
+        BasicProtocol<ConcurrentSendUart<CountingUart, 1024>> mpsc_protocol(tx);
+        std::atomic<bool> stop{false};
+        std::thread drainer([&]
+                            {
+            while (!stop.load(std::memory_order_acquire))
+            {
+                if (tx.drain() == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+            tx.drain(); });
+        double mpsc_rate = run_producers(producers, [&](const uint8_t *payload, size_t len)
+                                         {
+            while (!mpsc_protocol.send_frame(config::DATA_TYPE, payload, len))
+            {
+                std::this_thread::yield(); // Backpressure: queue full
+            } });
+        stop.store(true, std::memory_order_release);
+        drainer.join();
+
+        bool complete = mpsc_uart.writes == (FRAMES_TOTAL / producers) * producers;
+        std::printf("%-10u %18.0f %18.0f%s\n", producers, mutex_rate, mpsc_rate, complete ? "" : "  (frames lost!)");
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include "bench_utility.hpp"
+#include "uart_protocol/protocol_engine.hpp"
+#include <algorithm>
+#include <deque>
+#include <random>
+
+/*
+ * Protocol Engine Benchmark (built with configUSE_NON_BLOCKING_API=1)
+ *
+ * A simulated peer ACKs every frame 2 ms after it was sent, loses 10% of the frames (forcing a
+ * retransmit after the ACK timeout) and sends its own DATA frames in between. The engine is driven
+ * with 10 step() calls per simulated millisecond. Reports the CPU time per step (p50/p99/max, measured
+ * outside and by the engine itself) and the delivery result.
+ */
+
+using namespace uart_protocol;
+using namespace uart_protocol::bench;
+
+static_assert(configUSE_NON_BLOCKING_API, "bench_engine must be built with configUSE_NON_BLOCKING_API=1");
+
+namespace
+{
+    class SimulatedPeer : public Uart
+    {
+    private:
+        struct Pending
+        {
+            uint32_t due_ms;
+            std::vector<uint8_t> bytes;
+        };
+
+        std::mt19937 rng_{7};
+        std::deque<Pending> pending_;
+        std::deque<uint8_t> rx_;
+        std::vector<uint8_t> ack_;
+
+    public:
+        uint32_t now_ms = 0;
+        uint64_t lost = 0;
+
+        SimulatedPeer() : ack_(construct_frame(Frame{config::ACK_TYPE, {}})) {}
+
+        bool init() override { return true; }
+        void deinit() override {}
+
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            do_not_optimize(data);
+            do_not_optimize(size);
+            if (rng_() % 10 == 0)
+            {
+                ++lost;
+                return true; // Lost on the wire, no ACK
+            }
+            pending_.push_back(Pending{now_ms + 2, ack_});
+            return true;
+        }
+
+        size_t receive_data(uint8_t *out_buffer, size_t max_bytes) override
+        {
+            while (!pending_.empty() && static_cast<int32_t>(now_ms - pending_.front().due_ms) >= 0)
+            {
+                rx_.insert(rx_.end(), pending_.front().bytes.begin(), pending_.front().bytes.end());
+                pending_.pop_front();
+            }
+            size_t n = 0;
+            while (n < max_bytes && !rx_.empty())
+            {
+                out_buffer[n++] = rx_.front();
+                rx_.pop_front();
+            }
+            return n;
+        }
+
+        // Unsolicited traffic from the peer
+        void inject_data(size_t payload_size)
+        {
+            std::vector<uint8_t> payload(payload_size, 0x3C);
+            auto frame = construct_frame(Frame{config::DATA_TYPE, payload});
+            rx_.insert(rx_.end(), frame.begin(), frame.end());
+        }
+    };
+
+    struct Outcome
+    {
+        size_t acked = 0;
+        size_t failed = 0;
+        size_t received = 0;
+    };
+
+    void on_sent(void *context, SendHandle, SendStatus status)
+    {
+        auto *outcome = static_cast<Outcome *>(context);
+        if (status == SendStatus::Acked)
+        {
+            ++outcome->acked;
+        }
+        else if (status == SendStatus::Failed)
+        {
+            ++outcome->failed;
+        }
+    }
+
+    void on_frame(void *context, const FrameView &)
+    {
+        ++static_cast<Outcome *>(context)->received;
+    }
+} // namespace
+
+int main()
+{
+    constexpr size_t FRAMES = 5000;
+    constexpr size_t STEPS_PER_MS = 10;
+
+    SimulatedPeer peer;
+    Protocol protocol(peer);
+    ProtocolEngine<Uart> engine(protocol);
+    engine.set_ack_timeout_ms(20);
+
+    // Align the engine's wheel with the simulated clock
+    peer.now_ms = timing::get_tick_ms();
+    Outcome outcome;
+    engine.set_frame_handler(&on_frame, &outcome);
+
+    std::vector<double> step_ns;
+    step_ns.reserve(FRAMES * 100);
+    std::vector<uint8_t> payload(64, 0xA5);
+    size_t queued = 0;
+    std::mt19937 rng(3);
+
+    while (outcome.acked + outcome.failed < FRAMES)
+    {
+        ++peer.now_ms;
+        if (rng() % 4 == 0)
+        {
+            peer.inject_data(rng() % 200);
+        }
+        for (size_t i = 0; i < STEPS_PER_MS; ++i)
+        {
+            if (queued < FRAMES && engine.send(config::DATA_TYPE, payload.data(), payload.size(), &on_sent, &outcome) != 0)
+            {
+                ++queued;
+            }
+            auto start = bench_clock::now();
+            engine.step(peer.now_ms);
+            step_ns.push_back(std::chrono::duration<double, std::nano>(bench_clock::now() - start).count());
+        }
+    }
+
+    std::sort(step_ns.begin(), step_ns.end());
+    auto percentile = [&](double p)
+    { return step_ns[static_cast<size_t>(p * static_cast<double>(step_ns.size() - 1))]; };
+
+    print_header("ProtocolEngine step() cost");
+    print_result("step p50", step_ns.size(), percentile(0.50));
+    print_result("step p99", step_ns.size(), percentile(0.99));
+    print_result("step p99.9", step_ns.size(), percentile(0.999));
+    print_result("step max (includes OS preemption)", step_ns.size(), step_ns.back());
+    std::printf("engine max_step_us: %u (RX budget %zu bytes/step)\n", engine.max_step_us(), config::ENGINE_RX_BUDGET);
+    std::printf("frames: %zu acked, %zu failed, %llu lost on the wire, %llu retransmits, %zu peer frames received\n",
+                outcome.acked, outcome.failed, static_cast<unsigned long long>(peer.lost),
+                static_cast<unsigned long long>(engine.retransmits()), outcome.received);
+    return 0;
+}
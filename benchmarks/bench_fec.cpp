@@ -0,0 +1,187 @@
+#include "bench_utility.hpp"
+#include "uart_protocol/fec.hpp"
+#include <random>
+
+/*
+ * FEC Benchmark
+ *
+ * Simulated half-duplex link with random bit errors: every attempt costs the frame's airtime plus a
+ * turnaround (waiting for the ACK/NACK), a failed attempt is retransmitted until it gets through.
+ *  - retransmit-only: plain frames, any bit error fails the CRC16
+ *  - FecCodec<Parity, 32>: frames with Reed-Solomon parity, decoded by the real codec
+ * Reports effective goodput (payload bytes per second of link time) and encode+decode CPU cost.
+ */
+
+using namespace uart_protocol;
+using namespace uart_protocol::bench;
+
+namespace
+{
+    constexpr double BAUD = 19200.0;        // 10 bits per byte on the wire
+    constexpr double TURNAROUND_S = 0.100;  // Half-duplex radio turnaround per attempt
+    constexpr size_t PAYLOAD_SIZE = 64;
+    constexpr size_t FRAMES = 2000;
+    constexpr size_t MAX_ATTEMPTS = 64;
+
+    class BitErrorChannel
+    {
+    private:
+        std::mt19937_64 rng_{12345};
+        double ber_;
+        std::geometric_distribution<uint64_t> gap_;
+        uint64_t next_error_;
+
+    public:
+        explicit BitErrorChannel(double ber) : ber_(ber), gap_(ber > 0 ? ber : 0.5), next_error_(ber > 0 ? gap_(rng_) : UINT64_MAX) {}
+
+        // Flip bits of a transmitted buffer (bit positions are continuous across calls)
+        void transmit(uint8_t *data, size_t len)
+        {
+            uint64_t bits = static_cast<uint64_t>(len) * 8;
+            uint64_t bit = 0;
+            while (ber_ > 0 && next_error_ < bits - bit)
+            {
+                bit += next_error_;
+                data[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+                ++bit;
+                next_error_ = gap_(rng_);
+            }
+            if (ber_ > 0)
+            {
+                next_error_ -= bits - bit;
+            }
+        }
+    };
+
+    struct LinkResult
+    {
+        double goodput = 0;  // Payload bytes per second of link time
+        double attempts = 0; // Average attempts per frame
+        size_t failed = 0;   // Frames not delivered within MAX_ATTEMPTS
+    };
+
+    // encode(payload, out) -> size, deliver(buffer, size) -> payload intact
+    template <typename Encode, typename Deliver>
+    LinkResult run_link(double ber, Encode &&encode, Deliver &&deliver)
+    {
+        BitErrorChannel channel(ber);
+        uint8_t payload[PAYLOAD_SIZE];
+        uint8_t wire[512];
+        double seconds = 0;
+        size_t attempts = 0;
+        size_t failed = 0;
+        for (size_t frame = 0; frame < FRAMES; ++frame)
+        {
+            for (size_t i = 0; i < PAYLOAD_SIZE; ++i)
+            {
+                payload[i] = static_cast<uint8_t>(frame * 31 + i);
+            }
+            bool delivered = false;
+            for (size_t attempt = 0; attempt < MAX_ATTEMPTS && !delivered; ++attempt)
+            {
+                size_t size = encode(payload, wire);
+                channel.transmit(wire, size);
+                seconds += static_cast<double>(size) * 10.0 / BAUD + TURNAROUND_S;
+                ++attempts;
+                FrameView view;
+                delivered = deliver(wire, size, view) && view.payload_size == PAYLOAD_SIZE &&
+                            std::memcmp(view.payload, payload, PAYLOAD_SIZE) == 0;
+            }
+            failed += delivered ? 0 : 1;
+        }
+        LinkResult result;
+        result.goodput = static_cast<double>((FRAMES - failed) * PAYLOAD_SIZE) / seconds;
+        result.attempts = static_cast<double>(attempts) / FRAMES;
+        result.failed = failed;
+        return result;
+    }
+
+    LinkResult run_plain(double ber)
+    {
+        return run_link(
+            ber,
+            [](const uint8_t *payload, uint8_t *out)
+            { return encode_frame(config::DATA_TYPE, payload, PAYLOAD_SIZE, out); },
+            [](const uint8_t *wire, size_t size, FrameView &view)
+            {
+                size_t consumed = 0;
+                return decode_frame(wire, size, view, consumed) == ParseStatus::Ok;
+            });
+    }
+
+    template <size_t Parity>
+    LinkResult run_fec(double ber)
+    {
+        using Codec = FecCodec<Parity, 32>;
+        uint8_t frame[MAX_FRAME_SIZE];
+        return run_link(
+            ber,
+            [](const uint8_t *payload, uint8_t *out)
+            { return Codec::encode(config::DATA_TYPE, payload, PAYLOAD_SIZE, out); },
+            [&frame](const uint8_t *wire, size_t size, FrameView &view)
+            {
+                size_t consumed = 0;
+                size_t corrected = 0;
+                return Codec::decode(wire, size, frame, view, consumed, corrected) == ParseStatus::Ok;
+            });
+    }
+
+    void print_row(const char *name, double ber, const LinkResult &result)
+    {
+        std::printf("%-18s %10.0e %14.1f %12.2f %8zu\n", name, ber, result.goodput, result.attempts, result.failed);
+    }
+
+    template <size_t Parity>
+    void bench_cpu(const char *name)
+    {
+        using Codec = FecCodec<Parity, 32>;
+        uint8_t payload[PAYLOAD_SIZE] = {1, 2, 3};
+        uint8_t wire[Codec::MAX_ENCODED_SIZE];
+        uint8_t frame[MAX_FRAME_SIZE];
+        size_t size = Codec::encode(config::DATA_TYPE, payload, PAYLOAD_SIZE, wire);
+        constexpr size_t iterations = 20000;
+
+        double encode_ns = measure_ns(iterations, [&]
+                                      { do_not_optimize(Codec::encode(config::DATA_TYPE, payload, PAYLOAD_SIZE, wire)); });
+        double clean_ns = measure_ns(iterations, [&]
+                                     {
+            FrameView view;
+            size_t consumed, corrected;
+            do_not_optimize(Codec::decode(wire, size, frame, view, consumed, corrected)); });
+        wire[10] ^= 0x5A; // One corrupted byte in the first block
+        double dirty_ns = measure_ns(iterations, [&]
+                                     {
+            FrameView view;
+            size_t consumed, corrected;
+            do_not_optimize(Codec::decode(wire, size, frame, view, consumed, corrected)); });
+
+        char label[64];
+        std::snprintf(label, sizeof(label), "%s encode", name);
+        print_result(label, iterations, encode_ns);
+        std::snprintf(label, sizeof(label), "%s decode (clean)", name);
+        print_result(label, iterations, clean_ns);
+        std::snprintf(label, sizeof(label), "%s decode (1 bad byte)", name);
+        print_result(label, iterations, dirty_ns);
+    }
+} // namespace
+
+int main()
+{
+    std::printf("\n=== Goodput over a bit-error link: %zu x %zu-byte frames, %.0f baud, %.0f ms turnaround ===\n",
+                FRAMES, PAYLOAD_SIZE, BAUD, TURNAROUND_S * 1000.0);
+    std::printf("%-18s %10s %14s %12s %8s\n", "mode", "BER", "goodput B/s", "attempts", "failed");
+
+    for (double ber : {0.0, 1e-5, 1e-4, 5e-4, 1e-3, 2e-3, 5e-3})
+    {
+        print_row("retransmit-only", ber, run_plain(ber));
+        print_row("fec parity 4", ber, run_fec<4>(ber));
+        print_row("fec parity 8", ber, run_fec<8>(ber));
+        print_row("fec parity 16", ber, run_fec<16>(ber));
+    }
+
+    print_header("FEC CPU cost (64-byte payload, block 32)");
+    bench_cpu<4>("parity 4");
+    bench_cpu<8>("parity 8");
+    bench_cpu<16>("parity 16");
+    return 0;
+}
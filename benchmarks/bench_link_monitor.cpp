@@ -0,0 +1,162 @@
+#include "bench_utility.hpp"
+#include "uart_protocol/link_monitor.hpp"
+#include <random>
+
+/*
+ * Link Monitor Benchmark
+ *
+ * 1000 simulated links on one TimerWheel (1 ms ticks), 120 s of virtual time:
+ *  - busy:  peer sends a frame every 100 ms, answers probes
+ *  - idle:  no traffic, peer answers probes after 20 ms
+ *  - dead:  peer dies after 30 s
+ *  - flaky: peer answers only every other probe
+ * Reports CPU time for the whole run, keep-alive bandwidth per link type (6-byte frames, as a share of
+ * 9600 baud) and the final states.
+ */
+
+using namespace uart_protocol;
+using namespace uart_protocol::bench;
+
+namespace
+{
+    constexpr size_t LINKS = 1000;
+    constexpr uint32_t DURATION_MS = 120000;
+    constexpr uint32_t REPLY_DELAY_MS = 20;
+    constexpr double BYTES_PER_SECOND_9600 = 960.0;
+
+    enum class Kind : uint8_t
+    {
+        Busy,
+        Idle,
+        Dead,
+        Flaky
+    };
+
+    struct SimLink;
+
+    struct Simulation
+    {
+        TimerWheel wheel{0};
+        LinkMonitor monitor{wheel};
+        uint32_t now = 0;
+    };
+
+    struct SimLink
+    {
+        Simulation *sim = nullptr;
+        Kind kind = Kind::Idle;
+        LinkLiveness liveness;
+        TimerNode reply;   // Peer's answer in flight
+        TimerNode traffic; // Busy peer's periodic frames
+        uint32_t probes_answered = 0;
+        uint64_t tx_bytes = 0;
+        uint32_t transitions = 0;
+
+        bool alive() const { return kind != Kind::Dead || sim->now < 30000; }
+    };
+
+    void on_reply(TimerNode &, void *context)
+    {
+        auto &link = *static_cast<SimLink *>(context);
+        link.sim->monitor.on_frame(link.liveness, config::ACK_TYPE);
+    }
+
+    void on_traffic(TimerNode &node, void *context)
+    {
+        auto &link = *static_cast<SimLink *>(context);
+        link.sim->monitor.on_frame(link.liveness, config::DATA_TYPE);
+        link.sim->wheel.schedule(node, 100, &on_traffic, &link);
+    }
+
+    bool send_frame(void *context, uint8_t type)
+    {
+        auto &link = *static_cast<SimLink *>(context);
+        link.tx_bytes += FRAME_OVERHEAD;
+        if (type != config::ARE_YOU_THERE_TYPE || !link.alive())
+        {
+            return true;
+        }
+        if (link.kind == Kind::Flaky && (link.probes_answered++ % 2) == 1)
+        {
+            return true;
+        }
+        link.sim->wheel.schedule(link.reply, REPLY_DELAY_MS, &on_reply, &link);
+        return true;
+    }
+
+    void on_change(void *context, LinkState, LinkState)
+    {
+        ++static_cast<SimLink *>(context)->transitions;
+    }
+
+    const char *kind_name(Kind kind)
+    {
+        switch (kind)
+        {
+        case Kind::Busy:
+            return "busy";
+        case Kind::Idle:
+            return "idle";
+        case Kind::Dead:
+            return "dead after 30 s";
+        default:
+            return "flaky (50% answers)";
+        }
+    }
+
+    const char *state_name(LinkState state)
+    {
+        return state == LinkState::Up ? "up" : state == LinkState::Degraded ? "degraded"
+                                                                            : "down";
+    }
+} // namespace
+
+int main()
+{
+    Simulation sim;
+    std::vector<SimLink> links(LINKS);
+    for (size_t i = 0; i < LINKS; ++i)
+    {
+        SimLink &link = links[i];
+        link.sim = &sim;
+        link.kind = static_cast<Kind>(i % 4);
+        sim.monitor.add(link.liveness, &send_frame, &on_change, &link);
+        if (link.kind == Kind::Busy)
+        {
+            sim.wheel.schedule(link.traffic, 1 + static_cast<uint32_t>(i % 100), &on_traffic, &link);
+        }
+    }
+
+    auto start = bench_clock::now();
+    for (sim.now = 1; sim.now <= DURATION_MS; ++sim.now)
+    {
+        sim.wheel.advance(sim.now);
+    }
+    double seconds = std::chrono::duration<double>(bench_clock::now() - start).count();
+
+    std::printf("\n=== Link monitor: %zu links, %u s virtual time ===\n", LINKS, DURATION_MS / 1000);
+    std::printf("wall time %.3f s (%.1f ns per link per simulated ms, includes simulated traffic)\n", seconds,
+                seconds * 1e9 / LINKS / DURATION_MS);
+    std::printf("%-22s %14s %14s %12s %12s\n", "link type", "probe B/s", "% of 9600 bd", "transitions", "final state");
+    for (int kind = 0; kind < 4; ++kind)
+    {
+        uint64_t bytes = 0;
+        uint64_t transitions = 0;
+        size_t count = 0;
+        LinkState state = LinkState::Up;
+        for (auto &link : links)
+        {
+            if (static_cast<int>(link.kind) == kind)
+            {
+                bytes += link.liveness.probes_sent() * FRAME_OVERHEAD;
+                transitions += link.transitions;
+                state = link.liveness.state();
+                ++count;
+            }
+        }
+        double per_link = static_cast<double>(bytes) / count / (DURATION_MS / 1000.0);
+        std::printf("%-22s %14.2f %13.2f%% %12.1f %12s\n", kind_name(static_cast<Kind>(kind)), per_link,
+                    100.0 * per_link / BYTES_PER_SECOND_9600, static_cast<double>(transitions) / count, state_name(state));
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "bench_utility.hpp"
+#include "uart_protocol/parallel_decoder.hpp"
+#include <random>
+#include <thread>
+
+/*
+ * Parallel Decoder Benchmark
+ *
+ * Builds a FrameIndex over a synthetic 64 MB stream (random frames, line noise, corrupt frames)
+ * with 1..16 workers and prints throughput and speedup over the single-threaded run.
+ * Every run is checked against the single-threaded index.
+ */
+
+using namespace uart_protocol;
+using namespace uart_protocol::bench;
+
+namespace
+{
+    std::vector<uint8_t> make_stream(size_t target_bytes)
+    {
+        std::mt19937 rng(11);
+        std::vector<uint8_t> stream;
+        stream.reserve(target_bytes + MAX_FRAME_SIZE);
+        uint8_t payload[MAX_FRAME_SIZE];
+        uint8_t frame[MAX_FRAME_SIZE];
+        while (stream.size() < target_bytes)
+        {
+            if (rng() % 100 == 0)
+            {
+                stream.push_back(static_cast<uint8_t>(rng())); // line noise
+            }
+            size_t len = rng() % 128;
+            for (size_t i = 0; i < len; ++i)
+            {
+                payload[i] = static_cast<uint8_t>(rng());
+            }
+            size_t frame_size = encode_frame(config::DATA_TYPE, payload, len, frame);
+            if (rng() % 500 == 0)
+            {
+                frame[frame_size - 1] ^= 0x01; // corrupt CRC
+            }
+            stream.insert(stream.end(), frame, frame + frame_size);
+        }
+        return stream;
+    }
+} // namespace
+
+int main()
+{
+    auto stream = make_stream(64u << 20);
+
+    std::printf("\n=== Parallel decoder: %.1f MB stream, %u hardware threads ===\n",
+                static_cast<double>(stream.size()) / 1e6, std::thread::hardware_concurrency());
+    std::printf("%-10s %12s %12s %10s %10s\n", "threads", "frames", "seconds", "GB/s", "speedup");
+
+    double baseline = 0.0;
+    FrameIndex reference;
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u})
+    {
+        auto start = bench_clock::now();
+        FrameIndex index = FrameIndex::build(stream.data(), stream.size(), threads);
+        double seconds = std::chrono::duration<double>(bench_clock::now() - start).count();
+
+        if (threads == 1)
+        {
+            baseline = seconds;
+            reference = index;
+        }
+        bool match = index.size() == reference.size();
+        for (size_t i = 0; match && i < index.size(); ++i)
+        {
+            match = index[i].offset == reference[i].offset;
+        }
+
+        std::printf("%-10u %12zu %12.3f %10.3f %9.2fx%s\n", threads, index.size(), seconds,
+                    static_cast<double>(stream.size()) / seconds / 1e9, baseline / seconds, match ? "" : "  MISMATCH");
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "bench_utility.hpp"
+#include "uart_protocol/protocol.hpp"
+
+/*
+ * Protocol Binding Benchmark
+ *
+ * Compares BasicProtocol<Uart> (virtual driver calls) with BasicProtocol<LoopbackUart>
+ * (LoopbackUart is final, so driver calls are statically bound):
+ *  - receive per-byte: send_frame + receive_frames of the ACK, receive_data() returns one byte per call,
+ *                      result divided by the ACK frame size. No clock reads, so the driver calls dominate.
+ *  - wait_ack:         send_frame_wait_ack with the ACK handed out in one chunk (includes clock reads).
+ * Build with -DCMAKE_BUILD_TYPE=Release: in a Debug build nothing is inlined and both bindings cost the same.
+ * With only one driver class in the program the compiler often devirtualizes the virtual case on its own,
+ * so expect a small difference here; static binding matters when that is not possible (several drivers,
+ * driver defined in another translation unit).
+ */
+
+using namespace uart_protocol;
+using namespace uart_protocol::bench;
+
+namespace
+{
+    template <typename UartT>
+    double run_receive(LoopbackUart &loopback, size_t iterations)
+    {
+        BasicProtocol<UartT> protocol(loopback);
+        protocol.init();
+        const uint8_t payload[] = {0xDE, 0xAD, 0xBE, 0xEF};
+        FrameView frames[4];
+        return measure_ns(iterations, [&]
+                          {
+            protocol.send_frame(config::DATA_TYPE, payload, sizeof(payload));
+            size_t count = protocol.receive_frames(frames, 4);
+            do_not_optimize(count); });
+    }
+
+    template <typename UartT>
+    double run_wait_ack(LoopbackUart &loopback, size_t iterations)
+    {
+        BasicProtocol<UartT> protocol(loopback);
+        protocol.init();
+        const std::vector<uint8_t> payload = {0xDE, 0xAD, 0xBE, 0xEF};
+        return measure_ns(iterations, [&]
+                          {
+            bool ok = protocol.send_frame_wait_ack(config::DATA_TYPE, payload, 1000);
+            do_not_optimize(ok); });
+    }
+} // namespace
+
+int main()
+{
+    constexpr size_t iterations = 200000;
+
+    print_header("Protocol binding");
+
+    {
+        LoopbackUart loopback(1);
+        const double bytes = static_cast<double>(loopback.ack_frame_size());
+        print_result("receive per-byte  BasicProtocol<Uart> (virtual)", iterations, run_receive<Uart>(loopback, iterations) / bytes);
+        print_result("receive per-byte  BasicProtocol<LoopbackUart>", iterations, run_receive<LoopbackUart>(loopback, iterations) / bytes);
+    }
+
+    {
+        LoopbackUart loopback(64);
+        print_result("wait_ack          BasicProtocol<Uart> (virtual)", iterations, run_wait_ack<Uart>(loopback, iterations));
+        print_result("wait_ack          BasicProtocol<LoopbackUart>", iterations, run_wait_ack<LoopbackUart>(loopback, iterations));
+    }
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "bench_utility.hpp"
+#include "uart_protocol/rx_ingest.hpp"
+#include <atomic>
+#include <thread>
+
+/*
+ * RX Ingest Benchmark
+ *
+ * A simulated "ISR" thread pushes an encoded frame stream into RxIngest while a task thread decodes it:
+ *  - byte mode:  on_rx_byte() per byte (RXNE interrupt)
+ *  - dma mode:   bytes written into a 256-byte circular DMA buffer, on_dma_rx() at half-transfer,
+ *                transfer-complete and at idle-line points between frames
+ * Paced runs keep the ISR behind the task (expect zero drops and every frame in order); unpaced runs
+ * push as fast as possible and check that whatever is dropped never produces a corrupt frame.
+ */
+
+using namespace uart_protocol;
+using namespace uart_protocol::bench;
+
+namespace
+{
+    constexpr size_t FRAMES = 200000;
+    constexpr size_t DMA_SIZE = 256;
+
+    std::vector<uint8_t> make_stream()
+    {
+        std::vector<uint8_t> stream;
+        uint8_t payload[64];
+        uint8_t frame[MAX_FRAME_SIZE];
+        for (size_t i = 0; i < FRAMES; ++i)
+        {
+            size_t len = 4 + i % 60;
+            for (size_t j = 0; j < len; ++j)
+            {
+                payload[j] = static_cast<uint8_t>(i >> (8 * (j % 4)));
+            }
+            size_t size = encode_frame(config::DATA_TYPE, payload, len, frame);
+            stream.insert(stream.end(), frame, frame + size);
+        }
+        return stream;
+    }
+
+    struct RunResult
+    {
+        double seconds = 0;
+        size_t frames = 0;
+        size_t out_of_order = 0;
+        uint32_t dropped = 0;
+    };
+
+    template <typename Producer>
+    RunResult run(Producer &&produce)
+    {
+        RxIngest<> ingest;
+        std::atomic<bool> done{false};
+        RunResult result;
+
+        std::thread task([&]
+                         {
+            uint32_t expected = 0;
+            auto on_frame = [&](const FrameView &frame)
+            {
+                uint32_t index = static_cast<uint32_t>(frame.payload[0]) | (static_cast<uint32_t>(frame.payload[1]) << 8) |
+                                 (static_cast<uint32_t>(frame.payload[2]) << 16) | (static_cast<uint32_t>(frame.payload[3]) << 24);
+                if (index < expected)
+                {
+                    ++result.out_of_order;
+                }
+                expected = index + 1;
+                ++result.frames;
+            };
+            for (;;)
+            {
+                bool finished = done.load(std::memory_order_acquire);
+                if (ingest.process(on_frame) == 0 && ingest.buffered_bytes() == 0)
+                {
+                    if (finished)
+                    {
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+            } });
+
+        auto start = bench_clock::now();
+        produce(ingest);
+        done.store(true, std::memory_order_release);
+        task.join();
+        result.seconds = std::chrono::duration<double>(bench_clock::now() - start).count();
+        result.dropped = ingest.dropped_bytes();
+        return result;
+    }
+
+    void wait_for_room(RxIngest<> &ingest, size_t bytes, bool paced)
+    {
+        while (paced && ingest.buffered_bytes() + bytes > config::RX_INGEST_BUFFER_SIZE / 2)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    RunResult run_bytes(const std::vector<uint8_t> &stream, bool paced)
+    {
+        return run([&](RxIngest<> &ingest)
+                   {
+            for (uint8_t byte : stream)
+            {
+                wait_for_room(ingest, 1, paced);
+                ingest.on_rx_byte(byte);
+            } });
+    }
+
+    RunResult run_dma(const std::vector<uint8_t> &stream, bool paced)
+    {
+        return run([&](RxIngest<> &ingest)
+                   {
+            static volatile uint8_t dma[DMA_SIZE];
+            ingest.attach_dma(dma, DMA_SIZE);
+            size_t write_pos = 0;
+            size_t since_event = 0;
+            for (size_t i = 0; i < stream.size(); ++i)
+            {
+                dma[write_pos] = stream[i];
+                write_pos = (write_pos + 1) % DMA_SIZE;
+                ++since_event;
+                // Half-transfer / transfer-complete, or idle line after a frame's last CRC byte
+                bool frame_end = i + 1 < stream.size() && stream[i + 1] == 0x55 && (i % 7) == 0;
+                if (write_pos == DMA_SIZE / 2 || write_pos == 0 || frame_end)
+                {
+                    wait_for_room(ingest, since_event, paced);
+                    ingest.on_dma_rx(write_pos == 0 ? DMA_SIZE : write_pos);
+                    since_event = 0;
+                }
+            }
+            ingest.on_dma_rx(write_pos); });
+    }
+
+    void print_run(const char *name, size_t bytes, const RunResult &result)
+    {
+        std::printf("%-24s %10.1f %12.0f %10zu %10u %8zu\n", name, static_cast<double>(bytes) / result.seconds / 1e6,
+                    static_cast<double>(result.frames) / result.seconds, result.frames, result.dropped, result.out_of_order);
+    }
+} // namespace
+
+int main()
+{
+    std::vector<uint8_t> stream = make_stream();
+    std::printf("\n=== RX ingest: %zu frames, %zu bytes, ring %zu bytes ===\n", FRAMES, stream.size(), config::RX_INGEST_BUFFER_SIZE);
+    std::printf("%-24s %10s %12s %10s %10s %8s\n", "mode", "MB/s", "frames/s", "frames", "dropped", "order");
+
+    print_run("byte ISR (paced)", stream.size(), run_bytes(stream, true));
+    print_run("byte ISR (unpaced)", stream.size(), run_bytes(stream, false));
+    print_run("DMA HT/TC/idle (paced)", stream.size(), run_dma(stream, true));
+    print_run("DMA HT/TC/idle (unpaced)", stream.size(), run_dma(stream, false));
+    return 0;
+}
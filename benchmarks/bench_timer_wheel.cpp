@@ -0,0 +1,83 @@
+#include "bench_utility.hpp"
+#include "uart_protocol/timer_wheel.hpp"
+#include <memory>
+#include <random>
+
+/*
+ * Timer Wheel Benchmark
+ *
+ * 100k armed timers with random delays (1 tick .. 60 s at 1 ms ticks):
+ *  - schedule / cancel cost per timer
+ *  - advance cost per tick with all timers armed, compared with scanning a deadline array every tick
+ *    (what polling timing::has_elapsed() for each deadline amounts to)
+ */
+
+using namespace uart_protocol;
+using namespace uart_protocol::bench;
+
+namespace
+{
+    constexpr size_t TIMER_COUNT = 100000;
+    constexpr uint32_t MAX_DELAY = 60000;
+
+    size_t fired_count = 0;
+    void on_fire(TimerNode &, void *) { ++fired_count; }
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(42);
+    std::vector<uint32_t> delays(TIMER_COUNT);
+    for (auto &delay : delays)
+    {
+        delay = 1 + rng() % MAX_DELAY;
+    }
+
+    auto timers = std::make_unique<TimerNode[]>(TIMER_COUNT);
+    auto wheel = std::make_unique<TimerWheel>(0);
+
+    print_header("Timer wheel: 100k armed timers");
+
+    size_t i = 0;
+    double schedule_ns = measure_ns(TIMER_COUNT, [&]
+                                    { wheel->schedule(timers[i], delays[i], on_fire, nullptr); ++i; });
+    print_result("schedule", TIMER_COUNT, schedule_ns);
+
+    i = 0;
+    double cancel_ns = measure_ns(TIMER_COUNT, [&]
+                                  { wheel->cancel(timers[i]); ++i; });
+    print_result("cancel", TIMER_COUNT, cancel_ns);
+
+    // Re-arm everything and advance tick by tick through the whole delay range
+    for (i = 0; i < TIMER_COUNT; ++i)
+    {
+        wheel->schedule(timers[i], delays[i], on_fire, nullptr);
+    }
+    uint32_t now = 0;
+    double advance_ns = measure_ns(MAX_DELAY, [&]
+                                   { wheel->advance(++now); });
+    print_result("advance 1 tick (incl. firing/cascading)", MAX_DELAY, advance_ns);
+    do_not_optimize(fired_count);
+
+    // Baseline: scan every deadline each tick
+    std::vector<uint32_t> deadlines(delays);
+    std::vector<uint8_t> done(TIMER_COUNT, 0);
+    constexpr size_t scan_ticks = 2000;
+    now = 0;
+    double scan_ns = measure_ns(scan_ticks, [&]
+                                {
+        ++now;
+        for (size_t k = 0; k < TIMER_COUNT; ++k)
+        {
+            if (!done[k] && static_cast<int32_t>(now - deadlines[k]) >= 0)
+            {
+                done[k] = 1;
+                ++fired_count;
+            }
+        } });
+    print_result("scan 1 tick (100k deadlines)", scan_ticks, scan_ns);
+    do_not_optimize(fired_count);
+
+    std::printf("fired: %zu, still armed: %zu\n", fired_count, wheel->armed());
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "bench_utility.hpp"
+#include "uart_protocol/frame_trace.hpp"
+#include "uart_protocol/mpsc_frame_queue.hpp"
+#include "uart_protocol/protocol.hpp"
+#include "uart_protocol/stream_decoder.hpp"
+#include <atomic>
+#include <thread>
+
+/*
+ * Trace Benchmark (built with configUSE_TRACING=1)
+ *
+ *  - cost of one trace::record() call
+ *  - send_frame_wait_ack() round trips with all trace points enabled
+ *  - 4 producer threads + 1 drainer on an MpscFrameQueue (one ring per thread)
+ * Writes the result as Chrome trace JSON (default /tmp/uart_protocol_trace.json, or argv[1]).
+ */
+
+using namespace uart_protocol;
+using namespace uart_protocol::bench;
+
+static_assert(configUSE_TRACING, "bench_trace must be built with configUSE_TRACING=1");
+
+namespace
+{
+    class NullUart : public Uart
+    {
+    public:
+        bool init() override { return true; }
+        void deinit() override {}
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            do_not_optimize(data);
+            do_not_optimize(size);
+            return true;
+        }
+        size_t receive_data(uint8_t *, size_t) override { return 0; }
+    };
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const char *path = argc > 1 ? argv[1] : "/tmp/uart_protocol_trace.json";
+
+    print_header("Frame tracing");
+
+    // Raw record cost (drained right after so the ring does not fill up)
+    constexpr size_t record_iterations = 2000;
+    double record_ns = measure_ns(record_iterations, []
+                                  { trace::record(trace::TracePoint::Encoded, 1, config::DATA_TYPE, 16); });
+    print_result("trace::record", record_iterations, record_ns);
+    trace::collect();
+
+    // ACK round trips: encoded, send_data, first_rx_byte, parsed, ack_matched per frame
+    LoopbackUart uart;
+    Protocol protocol(uart);
+    std::vector<uint8_t> payload(32, 0xA5);
+    constexpr size_t round_trips = 500;
+    double round_trip_ns = measure_ns(round_trips, [&]
+                                      { do_not_optimize(protocol.send_frame_wait_ack(config::DATA_TYPE, payload)); });
+    print_result("send_frame_wait_ack (traced)", round_trips, round_trip_ns);
+
+    // Several producer threads, one drainer, a decoder on the drained bytes
+    MpscFrameQueue<256> queue;
+    NullUart sink;
+    std::atomic<bool> stop{false};
+    std::thread drainer([&]
+                        {
+        while (!stop.load(std::memory_order_acquire))
+        {
+            if (queue.drain(sink) == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+        queue.drain(sink); });
+    std::vector<std::thread> producers;
+    for (uint8_t t = 0; t < 4; ++t)
+    {
+        producers.emplace_back([&queue, t]
+                               {
+            uint8_t data[8] = {t};
+            for (int i = 0; i < 200; ++i)
+            {
+                while (queue.push_frame(config::DATA_TYPE, data, sizeof(data)) != TxStatus::Queued)
+                {
+                    std::this_thread::yield();
+                }
+            } });
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    stop.store(true, std::memory_order_release);
+    drainer.join();
+
+    StreamDecoder decoder;
+    uint8_t frame[MAX_FRAME_SIZE];
+    size_t size = encode_frame(config::ACK_TYPE, nullptr, 0, frame);
+    for (int i = 0; i < 100; ++i)
+    {
+        decoder.feed(frame, size, [](const FrameView &) {});
+    }
+
+    std::FILE *file = std::fopen(path, "w");
+    if (file == nullptr)
+    {
+        std::printf("cannot write %s\n", path);
+        return 1;
+    }
+    size_t events = trace::write_chrome_trace(file);
+    std::fclose(file);
+    std::printf("\n%zu trace points written to %s (%llu dropped), open in ui.perfetto.dev or chrome://tracing\n",
+                events, path, static_cast<unsigned long long>(trace::dropped_events()));
+    return 0;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include "uart_protocol/peripheral.hpp"
+#include "uart_protocol/ProtocolConfig.hpp"
+#include "uart_protocol/frame_utility.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/*
+ * Bench Utility - Minimal helpers shared by the benchmark executables.
+ *
+ * The benchmarks are plain executables (no external framework) so they can be built anywhere the
+ * library builds. Each one prints a small table: name, iterations and nanoseconds per operation.
+ */
+
+namespace uart_protocol::bench
+{
+    // Keep a value alive so the optimizer cannot drop the computation that produced it.
+    template <typename T>
+    inline void do_not_optimize(T const &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+
+    using bench_clock = std::chrono::steady_clock;
+
+    // Run `fn` `iterations` times and return the average cost in nanoseconds.
+    template <typename Fn>
+    inline double measure_ns(size_t iterations, Fn &&fn)
+    {
+        auto start = bench_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            fn();
+        }
+        auto end = bench_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+    }
+
+    inline void print_header(const char *title)
+    {
+        std::printf("\n=== %s ===\n", title);
+        std::printf("%-48s %14s %14s\n", "benchmark", "iterations", "ns/op");
+    }
+
+    inline void print_result(const char *name, size_t iterations, double ns_per_op)
+    {
+        std::printf("%-48s %14zu %14.2f\n", name, iterations, ns_per_op);
+    }
+
+    /*
+     * LoopbackUart - In-memory transport used by the benchmarks.
+     * Every frame handed to send_data() is answered with a pre-encoded ACK frame on the RX side,
+     * and receive_data() hands out at most `chunk_size` bytes per call (1 = byte-by-byte polling).
+     */
+    class LoopbackUart final : public Uart
+    {
+    private:
+        std::vector<uint8_t> ack_frame_;
+        uint8_t rx_[512];
+        size_t rx_head_ = 0;
+        size_t rx_tail_ = 0;
+        size_t chunk_size_;
+
+    public:
+        explicit LoopbackUart(size_t chunk_size = 64) : chunk_size_(chunk_size)
+        {
+            ack_frame_ = construct_frame(Frame{config::ACK_TYPE, {}});
+        }
+
+        bool init() override { return true; }
+        void deinit() override {}
+
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            do_not_optimize(data);
+            do_not_optimize(size);
+            // Reply with an ACK
+            std::memcpy(rx_, ack_frame_.data(), ack_frame_.size());
+            rx_head_ = 0;
+            rx_tail_ = ack_frame_.size();
+            return true;
+        }
+
+        size_t receive_data(uint8_t *out_buffer, size_t max_bytes) override
+        {
+            size_t available = rx_tail_ - rx_head_;
+            size_t n = available < max_bytes ? available : max_bytes;
+            n = n < chunk_size_ ? n : chunk_size_;
+            std::memcpy(out_buffer, rx_ + rx_head_, n);
+            rx_head_ += n;
+            return n;
+        }
+
+        size_t ack_frame_size() const { return ack_frame_.size(); }
+    };
+} // namespace uart_protocol::bench
@@ -57,9 +57,7 @@ int main()
                                 {
         std::cout << "Receiver Thread started, waiting for frames..." << std::endl;
         
-        std::vector<uint8_t> recv_buffer;
-        recv_buffer.reserve(uart_protocol::config::MAX_PAYLOAD_SIZE);
-        uint8_t temp_buffer[64];
+        uart_protocol::FrameView received_frames[8];
         
         while (!test_complete.load()) {
             // Simulate data transfer from producer to receiver
@@ -71,26 +69,15 @@ int main()
                 }
             }
             
-            // Try to receive data
-            size_t n = receiver_uart.receive_data(temp_buffer, sizeof(temp_buffer));
-            if (n > 0) {
-                recv_buffer.insert(recv_buffer.end(), temp_buffer, temp_buffer + n);
+            // Receive all complete frames in one call
+            size_t count = receiver_protocol.receive_frames(received_frames, sizeof(received_frames) / sizeof(received_frames[0]));
+            for (size_t i = 0; i < count; ++i) {
+                std::cout << "Receiver Frame received! Type: 0x" << std::hex << static_cast<int>(received_frames[i].type) 
+                          << ", Payload size: " << std::dec << received_frames[i].payload_size << std::endl;
                 
-                // Try to parse frame
-                uart_protocol::Frame received_frame;
-                size_t consumed_bytes = 0;
-                
-                if (uart_protocol::parse_frame(recv_buffer, received_frame, consumed_bytes)) {
-                    std::cout << "Receiver Frame received! Type: 0x" << std::hex << static_cast<int>(received_frame.type) 
-                              << ", Payload size: " << std::dec << received_frame.payload.size() << std::endl;
-                    
-                    // Clear the buffer after successful parse
-                    recv_buffer.clear();
-                    
-                    // Send ACK back
-                    std::cout << "Receiver Sending ACK..." << std::endl;
-                    receiver_protocol.send_ack();
-                }
+                // Send ACK back
+                std::cout << "Receiver Sending ACK..." << std::endl;
+                receiver_protocol.send_ack();
             }
             
             // Simulate data transfer from receiver to producer (ACK)
@@ -0,0 +1,333 @@
+#pragma once
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+ * Linux Async File Writer - Batched, rotating log file writer with its own I/O thread.
+ *
+ * The producer appends into a large in-memory buffer. Full buffers (or partially filled ones after
+ * the flush interval) are handed to the I/O thread, which writes each buffer with as few write(2)
+ * calls as possible and rotates to a new file once the size limit is reached.
+ *
+ *  - Buffers come from a fixed pool allocated at open(), appending never allocates.
+ *  - If every buffer is waiting for the disk, append() drops the data and counts it (never blocks).
+ *  - Optional O_DIRECT: buffers are page aligned and only full buffers are written, bypassing the
+ *    page cache. The unaligned tail is written without O_DIRECT at close().
+ *
+ * Files are named <prefix>.<NNNN>.log.
+ *
+ * Usage:
+ *   uart_protocol::AsyncFileWriter writer;
+ *   uart_protocol::AsyncFileWriter::Options options;
+ *   options.path_prefix = "/var/log/uart/link";
+ *   writer.open(options);
+ *   writer.append(line, line_len);   // producer thread
+ *   writer.poll();                   // producer thread, hands off stale partial buffers
+ *   writer.close();
+ */
+
+namespace uart_protocol
+{
+    class AsyncFileWriter
+    {
+    public:
+        struct Options
+        {
+            std::string path_prefix = "uart_log";
+            size_t buffer_size = size_t{4} << 20;        // Bytes per buffer (multiple of 4096 for O_DIRECT)
+            size_t buffer_count = 8;                     // Buffers in the pool
+            uint64_t rotate_bytes = uint64_t{256} << 20; // Start a new file after this many bytes, 0 = never
+            uint32_t flush_interval_ms = 200;            // Hand off a partial buffer after this long (ignored with O_DIRECT)
+            bool direct_io = false;                      // Open files with O_DIRECT
+        };
+
+    private:
+        struct Buffer
+        {
+            uint8_t *data = nullptr;
+            size_t size = 0;
+        };
+
+        Options options_;
+        std::vector<Buffer> pool_;
+        std::deque<Buffer *> free_;
+        std::deque<Buffer *> full_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::thread io_thread_;
+        bool stop_ = false;
+
+        Buffer *current_ = nullptr;                       // Producer owned
+        std::chrono::steady_clock::time_point current_since_;
+
+        int fd_ = -1;
+        uint32_t file_index_ = 0;
+        uint64_t file_bytes_ = 0;
+        bool open_ = false;
+
+        std::atomic<uint64_t> backlog_bytes_{0}; // Handed off, not yet on disk
+        std::atomic<uint64_t> written_bytes_{0};
+        std::atomic<uint64_t> dropped_bytes_{0};
+        std::atomic<uint64_t> write_errors_{0};
+        std::atomic<uint32_t> files_{0};
+
+        bool open_file()
+        {
+            char suffix[16];
+            std::snprintf(suffix, sizeof(suffix), ".%04u.log", file_index_++);
+            std::string path = options_.path_prefix + suffix;
+            int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+#if defined(O_DIRECT)
+            if (options_.direct_io)
+            {
+                flags |= O_DIRECT;
+            }
+#endif
+            fd_ = ::open(path.c_str(), flags, 0644);
+            file_bytes_ = 0;
+            if (fd_ >= 0)
+            {
+                files_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return fd_ >= 0;
+        }
+
+        bool write_all(int fd, const uint8_t *data, size_t size)
+        {
+            while (size > 0)
+            {
+                ssize_t n = ::write(fd, data, size);
+                if (n < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    write_errors_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                data += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        // I/O thread: write handed-off buffers in order, rotate between buffers
+        void io_thread_func()
+        {
+            for (;;)
+            {
+                Buffer *buffer;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait(lock, [this]
+                             { return stop_ || !full_.empty(); });
+                    if (full_.empty())
+                    {
+                        return; // stop_ and nothing left
+                    }
+                    buffer = full_.front();
+                    full_.pop_front();
+                }
+
+                if (fd_ >= 0 && write_all(fd_, buffer->data, buffer->size))
+                {
+                    file_bytes_ += buffer->size;
+                    written_bytes_.fetch_add(buffer->size, std::memory_order_relaxed);
+                }
+                backlog_bytes_.fetch_sub(buffer->size, std::memory_order_relaxed);
+
+                if (options_.rotate_bytes > 0 && file_bytes_ >= options_.rotate_bytes)
+                {
+                    ::close(fd_);
+                    open_file();
+                }
+
+                buffer->size = 0;
+                std::lock_guard<std::mutex> lock(mutex_);
+                free_.push_back(buffer);
+            }
+        }
+
+        // Producer: queue the current buffer for writing
+        void hand_off()
+        {
+            if (current_ == nullptr || current_->size == 0)
+            {
+                return;
+            }
+            backlog_bytes_.fetch_add(current_->size, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                full_.push_back(current_);
+            }
+            cv_.notify_one();
+            current_ = nullptr;
+        }
+
+        // Producer: get an empty buffer, nullptr if all are in flight
+        Buffer *acquire()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (free_.empty())
+            {
+                return nullptr;
+            }
+            Buffer *buffer = free_.front();
+            free_.pop_front();
+            current_since_ = std::chrono::steady_clock::now();
+            return buffer;
+        }
+
+    public:
+        AsyncFileWriter() = default;
+        ~AsyncFileWriter() { close(); }
+
+        AsyncFileWriter(const AsyncFileWriter &) = delete;
+        AsyncFileWriter &operator=(const AsyncFileWriter &) = delete;
+
+        // Allocate the buffer pool, open the first file and start the I/O thread
+        bool open(const Options &options)
+        {
+            if (open_)
+            {
+                return false;
+            }
+            options_ = options;
+            if (options_.buffer_count == 0 || options_.buffer_size == 0 ||
+                (options_.direct_io && options_.buffer_size % 4096 != 0))
+            {
+                return false;
+            }
+            if (!open_file())
+            {
+                return false;
+            }
+
+            pool_.resize(options_.buffer_count);
+            for (auto &buffer : pool_)
+            {
+                void *memory = nullptr;
+                if (::posix_memalign(&memory, 4096, options_.buffer_size) != 0)
+                {
+                    close();
+                    return false;
+                }
+                buffer.data = static_cast<uint8_t *>(memory);
+                free_.push_back(&buffer);
+            }
+
+            stop_ = false;
+            io_thread_ = std::thread(&AsyncFileWriter::io_thread_func, this);
+            open_ = true;
+            return true;
+        }
+
+        // Producer: append bytes. Returns false if (part of) them were dropped because every buffer is in flight.
+        bool append(const void *data, size_t size)
+        {
+            const uint8_t *bytes = static_cast<const uint8_t *>(data);
+            while (size > 0)
+            {
+                if (current_ == nullptr && (current_ = acquire()) == nullptr)
+                {
+                    dropped_bytes_.fetch_add(size, std::memory_order_relaxed);
+                    return false;
+                }
+                size_t room = options_.buffer_size - current_->size;
+                size_t n = size < room ? size : room;
+                std::memcpy(current_->data + current_->size, bytes, n);
+                current_->size += n;
+                bytes += n;
+                size -= n;
+                if (current_->size == options_.buffer_size)
+                {
+                    hand_off();
+                }
+            }
+            return true;
+        }
+
+        // Producer: hand off a partial buffer once it is older than the flush interval (not with O_DIRECT)
+        void poll()
+        {
+            if (current_ == nullptr || current_->size == 0 || options_.direct_io)
+            {
+                return;
+            }
+            auto age = std::chrono::steady_clock::now() - current_since_;
+            if (age >= std::chrono::milliseconds(options_.flush_interval_ms))
+            {
+                hand_off();
+            }
+        }
+
+        // Write everything still buffered and close the file
+        void close()
+        {
+            if (open_)
+            {
+                Buffer *tail = current_;
+                current_ = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stop_ = true;
+                }
+                cv_.notify_one();
+                io_thread_.join();
+
+                // Tail of a partial buffer: O_DIRECT needs aligned sizes, so drop the flag for it
+                if (tail != nullptr && tail->size > 0 && fd_ >= 0)
+                {
+#if defined(O_DIRECT)
+                    if (options_.direct_io)
+                    {
+                        ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) & ~O_DIRECT);
+                    }
+#endif
+                    if (write_all(fd_, tail->data, tail->size))
+                    {
+                        written_bytes_.fetch_add(tail->size, std::memory_order_relaxed);
+                    }
+                }
+                open_ = false;
+            }
+            if (fd_ >= 0)
+            {
+                ::close(fd_);
+                fd_ = -1;
+            }
+            for (auto &buffer : pool_)
+            {
+                std::free(buffer.data);
+            }
+            pool_.clear();
+            free_.clear();
+            full_.clear();
+        }
+
+        // Bytes appended but not yet written (in the producer buffer or queued for the I/O thread). Call from the producer thread.
+        uint64_t backlog_bytes() const
+        {
+            return backlog_bytes_.load(std::memory_order_relaxed) + (current_ != nullptr ? current_->size : 0);
+        }
+        uint64_t written_bytes() const { return written_bytes_.load(std::memory_order_relaxed); }
+        uint64_t dropped_bytes() const { return dropped_bytes_.load(std::memory_order_relaxed); }
+        uint64_t write_errors() const { return write_errors_.load(std::memory_order_relaxed); }
+        uint32_t files() const { return files_.load(std::memory_order_relaxed); }
+        bool is_open() const { return open_; }
+    };
+} // namespace uart_protocol
@@ -0,0 +1,239 @@
+#pragma once
+#include "uart_protocol/peripheral.hpp"
+#include "uart_protocol/spsc_ring.hpp"
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+/*
+ * Linux Serial Port - termios implementation of the Uart interface.
+ *
+ * A reader thread blocks in poll()/read() on the tty and pushes everything into a lock-free SPSC ring,
+ * receive_data() pops from the ring. The ring absorbs scheduling hiccups of the consumer (4 MB is
+ * ~14 s at 3 Mbaud), overflows are counted in dropped_bytes() instead of stalling the reader.
+ *
+ * Usage:
+ *   uart_protocol::SerialPort port;
+ *   port.set_port("/dev/ttyUSB0");
+ *   port.set_baudrate(3000000);
+ *   if (port.init()) {
+ *       // Port opened successfully
+ *   }
+ */
+
+namespace uart_protocol
+{
+    class SerialPort : public Uart
+    {
+    public:
+        static constexpr size_t RX_RING_SIZE = size_t{1} << 22;
+        using RxRing = SpscRing<RX_RING_SIZE>;
+
+    private:
+        std::thread read_thread_;
+        std::atomic<bool> stop_reading_{false};
+        std::unique_ptr<RxRing> rx_ring_;
+        std::atomic<uint64_t> rx_bytes_{0};
+        std::atomic<uint64_t> dropped_bytes_{0};
+
+        int fd_ = -1;
+        std::string port_name_ = "/dev/ttyUSB0"; // Default tty
+        uint32_t baudrate_ = 115200;             // Default baud rate
+        bool initialized_ = false;
+
+        static speed_t to_speed(uint32_t baudrate)
+        {
+            switch (baudrate)
+            {
+            case 9600: return B9600;
+            case 19200: return B19200;
+            case 38400: return B38400;
+            case 57600: return B57600;
+            case 115200: return B115200;
+            case 230400: return B230400;
+            case 460800: return B460800;
+            case 500000: return B500000;
+            case 576000: return B576000;
+            case 921600: return B921600;
+            case 1000000: return B1000000;
+            case 1152000: return B1152000;
+            case 1500000: return B1500000;
+            case 2000000: return B2000000;
+            case 2500000: return B2500000;
+            case 3000000: return B3000000;
+            case 3500000: return B3500000;
+            case 4000000: return B4000000;
+            default: return B0;
+            }
+        }
+
+        // Background reading thread function
+        void read_thread_func()
+        {
+            uint8_t temp_buffer[1 << 16];
+            pollfd pfd{fd_, POLLIN, 0};
+
+            while (!stop_reading_.load(std::memory_order_relaxed))
+            {
+                int ready = ::poll(&pfd, 1, 100); // Wake up periodically to check stop_reading_
+                if (ready <= 0)
+                {
+                    continue;
+                }
+                ssize_t n = ::read(fd_, temp_buffer, sizeof(temp_buffer));
+                if (n <= 0)
+                {
+                    continue;
+                }
+                size_t stored = rx_ring_->push(temp_buffer, static_cast<size_t>(n));
+                rx_bytes_.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+                if (stored < static_cast<size_t>(n))
+                {
+                    dropped_bytes_.fetch_add(static_cast<uint64_t>(n) - stored, std::memory_order_relaxed);
+                }
+            }
+        }
+
+    public:
+        SerialPort() = default;
+
+        ~SerialPort() override
+        {
+            deinit();
+        }
+
+        // Set tty device (e.g., "/dev/ttyUSB0", "/dev/ttyACM0")
+        void set_port(const std::string &port)
+        {
+            port_name_ = port;
+        }
+
+        // Set baud rate (standard Linux rates from 9600 up to 4000000)
+        void set_baudrate(uint32_t baudrate)
+        {
+            baudrate_ = baudrate;
+        }
+
+        bool init() override
+        {
+            if (initialized_)
+            {
+                return true; // Already initialized
+            }
+
+            speed_t speed = to_speed(baudrate_);
+            if (speed == B0)
+            {
+                return false; // Unsupported baud rate
+            }
+
+            fd_ = ::open(port_name_.c_str(), O_RDWR | O_NOCTTY | O_CLOEXEC);
+            if (fd_ < 0)
+            {
+                return false;
+            }
+
+            // Raw 8N1, no flow control, read() returns whatever is available
+            termios tty{};
+            if (::tcgetattr(fd_, &tty) != 0)
+            {
+                ::close(fd_);
+                fd_ = -1;
+                return false;
+            }
+            ::cfmakeraw(&tty);
+            tty.c_cflag |= CLOCAL | CREAD;
+            tty.c_cflag &= ~(CSTOPB | PARENB | CRTSCTS);
+            tty.c_cc[VMIN] = 0;
+            tty.c_cc[VTIME] = 0;
+            ::cfsetispeed(&tty, speed);
+            ::cfsetospeed(&tty, speed);
+            if (::tcsetattr(fd_, TCSANOW, &tty) != 0)
+            {
+                ::close(fd_);
+                fd_ = -1;
+                return false;
+            }
+
+            // Purge any existing data
+            ::tcflush(fd_, TCIOFLUSH);
+
+            rx_ring_ = std::make_unique<RxRing>();
+            stop_reading_.store(false);
+            read_thread_ = std::thread(&SerialPort::read_thread_func, this);
+
+            initialized_ = true;
+            return true;
+        }
+
+        void deinit() override
+        {
+            if (!initialized_)
+            {
+                return;
+            }
+
+            // Stop background thread
+            stop_reading_.store(true);
+            if (read_thread_.joinable())
+            {
+                read_thread_.join();
+            }
+
+            ::close(fd_);
+            fd_ = -1;
+            initialized_ = false;
+        }
+
+        // Send data over the tty, retrying partial writes
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            if (!initialized_)
+            {
+                return false;
+            }
+            while (size > 0)
+            {
+                ssize_t n = ::write(fd_, data, size);
+                if (n < 0)
+                {
+                    if (errno == EINTR || errno == EAGAIN)
+                    {
+                        continue;
+                    }
+                    return false;
+                }
+                data += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        // Receive data from the RX ring (non-blocking)
+        size_t receive_data(uint8_t *out_buffer, size_t max_bytes) override
+        {
+            if (!initialized_)
+            {
+                return 0;
+            }
+            return rx_ring_->pop(out_buffer, max_bytes);
+        }
+
+        // Zero-copy access for a consumer that decodes in place (nullptr before init())
+        RxRing *rx_ring() { return rx_ring_.get(); }
+
+        // Bytes read from the tty, bytes lost because the ring was full, bytes waiting in the ring
+        uint64_t rx_bytes() const { return rx_bytes_.load(std::memory_order_relaxed); }
+        uint64_t dropped_bytes() const { return dropped_bytes_.load(std::memory_order_relaxed); }
+        size_t backlog_bytes() const { return rx_ring_ ? rx_ring_->size() : 0; }
+
+        const std::string &port() const { return port_name_; }
+        bool is_open() const { return initialized_; }
+    };
+} // namespace uart_protocol
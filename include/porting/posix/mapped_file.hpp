@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * POSIX Mapped File - Read-only memory mapping of a file (Linux, macOS).
+ *
+ * Used to replay and decode capture files without reading them into a heap buffer.
+ *
+ * Usage:
+ *   uart_protocol::MappedFile file;
+ *   if (file.open("link.upcap")) {
+ *       use(file.data(), file.size());
+ *   }
+ */
+
+namespace uart_protocol
+{
+    class MappedFile
+    {
+    private:
+        const uint8_t *data_ = nullptr;
+        size_t size_ = 0;
+
+    public:
+        MappedFile() = default;
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        // Map a whole file read-only. Returns false if it cannot be opened or mapped (empty files included).
+        bool open(const char *path)
+        {
+            close();
+            int fd = ::open(path, O_RDONLY);
+            if (fd < 0)
+            {
+                return false;
+            }
+
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            void *mapping = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd); // The mapping keeps the file referenced
+            if (mapping == MAP_FAILED)
+            {
+                return false;
+            }
+
+            // Captures are read front to back: let the kernel read ahead aggressively
+            ::madvise(mapping, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+            data_ = static_cast<const uint8_t *>(mapping);
+            size_ = static_cast<size_t>(st.st_size);
+            return true;
+        }
+
+        void close()
+        {
+            if (data_ != nullptr)
+            {
+                ::munmap(const_cast<uint8_t *>(data_), size_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+
+        const uint8_t *data() const { return data_; }
+        size_t size() const { return size_; }
+        bool is_open() const { return data_ != nullptr; }
+    };
+} // namespace uart_protocol
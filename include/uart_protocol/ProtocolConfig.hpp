@@ -14,11 +14,17 @@
 #define configUSE_STD_CHRONO 1 // Set to 1 to use std::chrono timing, 0 for FreeRTOS or bare-metal
 #define configUSE_FREERTOS 0   // Set to 1 to use FreeRTOS timing, 0 for std::chrono or bare-metal
 #define configBARE_METAL 0     // Set to 1 to use bare-metal timing, 0 for std::chrono or FreeRTOS
+// #define configTIMING_GET_TICK_US64() esp_timer_get_time() // FreeRTOS: optional microsecond timer source (default: tick count)
 /* Protocol behavior configuration */
 #define configUSE_STATIC_BUFFERS 0   // Set to 1 to use static buffers (for embedded compatibility), 0 for dynamic std::vector
-#define configUSE_NON_BLOCKING_API 0 // Set to 1 to enable non-blocking API (for waiting events), 0 for blocking API
+#ifndef configUSE_NON_BLOCKING_API
+#define configUSE_NON_BLOCKING_API 0 // Set to 1 to enable the non-blocking ProtocolEngine (poll()/step()), 0 for the blocking API only
+#endif
 #define configUSE_ERROR_HANDLING 0   // Set to 1 to enable error handling features, 0 to disable
 #define configUSE_LOGGING 1          // Set to 1 to enable logging features, 0 to disable
+#ifndef configUSE_TRACING
+#define configUSE_TRACING 0          // Set to 1 to record per-frame trace points (std::chrono platform only), 0 compiles them out
+#endif
 
 // Namespace for protocol configuration constants
 namespace uart_protocol::config
@@ -35,12 +41,67 @@ namespace uart_protocol::config
     inline constexpr uint8_t CMD_TYPE = 0x06;           // Frame type for CMD (Command frame) – edit if needed
     inline constexpr uint8_t RESP_TYPE = 0x07;          // Frame type for RESP (Response frame) – edit if needed
     inline constexpr uint8_t ERROR_TYPE = 0x08;         // Frame type for ERROR – edit if needed
+    inline constexpr uint8_t CHANNEL_DATA_TYPE = 0x09;  // Frame type for multiplexed channel data – edit if needed
+    inline constexpr uint8_t CREDIT_TYPE = 0x0A;        // Frame type for channel credit grants – edit if needed
 
     // Max payload size
     inline constexpr size_t MAX_PAYLOAD_SIZE = 255; // Max payload size due to LEN being 1 byte
 
     // Default timeouts
     inline constexpr uint32_t DEFAULT_ACK_TIMEOUT_MS = 200; // Default timeout for ACK wait
+    inline constexpr uint32_t RX_POLL_INTERVAL_MS = 1;      // Sleep between empty receive polls while waiting for an ACK
+
+    // Batch receive buffer (BasicProtocol::receive_frames) – edit if needed
+    inline constexpr size_t RX_BATCH_BUFFER_SIZE = 4096; // Bytes buffered per protocol, at least 2 * MAX_FRAME_SIZE
+
+    // CMD/RESP transactions – edit if needed
+    inline constexpr size_t MAX_PENDING_TRANSACTIONS = 8;         // Commands in flight per link
+    inline constexpr uint32_t DEFAULT_RESPONSE_TIMEOUT_MS = 500;  // Default timeout for a RESP frame
+
+    // Non-blocking engine (configUSE_NON_BLOCKING_API) – edit if needed
+    inline constexpr size_t ENGINE_QUEUE_DEPTH = 8;  // Frames waiting to be sent and ACKed
+    inline constexpr uint8_t ENGINE_MAX_RETRIES = 3; // Retransmits after the first attempt before a frame fails
+    inline constexpr size_t ENGINE_RX_BUDGET = 64;   // Max bytes read and decoded per step (bounds the step time)
+
+    // Link liveness (LinkMonitor) – edit if needed
+    inline constexpr uint32_t LINK_IDLE_MS = 1000;               // Silence before an ARE_YOU_THERE probe is sent
+    inline constexpr uint32_t LINK_PROBE_TIMEOUT_MS = 250;       // Time allowed for any reply to a probe
+    inline constexpr uint32_t LINK_DOWN_PROBE_INTERVAL_MS = 5000; // Probe period while a link is down
+    inline constexpr uint8_t LINK_DEGRADED_AFTER = 1;            // Unanswered probes before Up -> Degraded
+    inline constexpr uint8_t LINK_DOWN_AFTER = 3;                // Unanswered probes before -> Down
+    inline constexpr uint8_t LINK_UP_AFTER = 2;                  // Consecutive frames before Degraded/Down -> Up
+
+    // Timer wheel geometry – edit if needed (range = 2^(LEVEL_BITS * LEVELS) ticks, longer delays are re-cascaded)
+    inline constexpr size_t TIMER_WHEEL_LEVEL_BITS = 6; // 64 slots per level
+    inline constexpr size_t TIMER_WHEEL_LEVELS = 4;     // 2^24 ticks (~4.6 h at 1 ms ticks) before re-cascading
+
+    // TX scheduler queue depths (frames per priority class) – edit if needed
+    inline constexpr size_t TX_CONTROL_QUEUE_DEPTH = 8;  // ACK/NACK/START/ARE_YOU_THERE/ERROR/CREDIT frames
+    inline constexpr size_t TX_COMMAND_QUEUE_DEPTH = 8;  // CMD/RESP frames
+    inline constexpr size_t TX_DATA_QUEUE_DEPTH = 16;    // DATA and any other frame type
+
+    // Channel multiplexing – edit if needed
+    inline constexpr size_t MUX_CHANNELS = 4;                // Logical channels per link
+    inline constexpr size_t MUX_RX_WINDOW = 4;               // Frames buffered per channel on the receiver (= sender credits)
+    inline constexpr size_t MUX_TX_QUEUE_DEPTH = 8;          // Frames queued per channel on the sender
+    inline constexpr uint32_t MUX_CREDIT_REFRESH_MS = 1000;  // Period for re-advertising all windows (recovers lost CREDIT frames)
+
+    // Forward error correction (FecUart) – edit if needed
+    inline constexpr size_t FEC_BLOCK_SIZE = 32;  // Data bytes per Reed-Solomon block
+    inline constexpr size_t FEC_PARITY_BYTES = 8; // Parity bytes per block (corrects FEC_PARITY_BYTES / 2 bad bytes per block)
+
+    // Frame tracing (configUSE_TRACING) – edit if needed
+    inline constexpr size_t TRACE_RING_SIZE = 1 << 16; // Bytes per recording thread (16 bytes per event), power of two
+
+    // ISR/DMA ingest ring (RxIngest) – edit if needed
+    inline constexpr size_t RX_INGEST_BUFFER_SIZE = 1024; // Bytes buffered between interrupt and task context, power of two
+
+    // Concurrent send queue depth (frames, power of two) – edit if needed
+    inline constexpr size_t TX_CONCURRENT_QUEUE_DEPTH = 64;
+
+    // TX coalescing defaults – edit if needed
+    inline constexpr size_t TX_COALESCE_BUFFER_SIZE = 512;    // Staging buffer size in bytes
+    inline constexpr uint32_t TX_COALESCE_MAX_DELAY_US = 500; // Max time a byte may wait in the staging buffer
 } // namespace uart_protocol::config
 
 /* Do not edit below this line */
@@ -0,0 +1,256 @@
+#pragma once
+#include "peripheral.hpp"
+#include "timing_utility.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+/*
+ * Capture - Wire capture tap and capture file format.
+ *
+ * CaptureUart wraps any driver and logs every RX/TX chunk with a microsecond timestamp to a
+ * CaptureWriter. CaptureReader walks a capture held in memory (e.g. a MappedFile) without copying.
+ *
+ * FILE FORMAT (all integers little-endian):
+ *   File header:   [MAGIC "UPCAP" 0x00 0x00 0x01 (8 bytes)] + [VERSION (4 bytes)] + [RESERVED (4 bytes)]
+ *   Record header: [TIMESTAMP_US (8 bytes)] + [DIRECTION (1 byte)] + [RESERVED (1 byte)] + [LEN (2 bytes)]
+ *   Record data:   [LEN bytes exactly as seen by the driver]
+ *
+ * Chunks larger than 65535 bytes are split into several records with the same timestamp.
+ *
+ * Usage:
+ *   uart_protocol::capture::CaptureWriter writer;
+ *   writer.open("link.upcap");
+ *   uart_protocol::capture::CaptureUart<MyUart> tap(my_uart, writer);
+ *   uart_protocol::Protocol protocol(tap); // all traffic is recorded
+ */
+
+namespace uart_protocol::capture
+{
+    inline constexpr uint8_t FILE_MAGIC[8] = {'U', 'P', 'C', 'A', 'P', 0x00, 0x00, 0x01};
+    inline constexpr uint32_t FILE_VERSION = 1;
+    inline constexpr size_t FILE_HEADER_SIZE = 16;
+    inline constexpr size_t RECORD_HEADER_SIZE = 12;
+    inline constexpr size_t MAX_RECORD_DATA = 0xFFFF;
+
+    enum class Direction : uint8_t
+    {
+        Rx = 0, // Bytes returned by receive_data()
+        Tx = 1  // Bytes the driver's send_data() accepted
+    };
+
+    // One captured chunk. `data` points into the capture buffer.
+    struct Record
+    {
+        uint64_t timestamp_us = 0;
+        Direction direction = Direction::Rx;
+        const uint8_t *data = nullptr;
+        size_t size = 0;
+    };
+
+    inline void store_le(uint8_t *out, uint64_t value, size_t bytes)
+    {
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    inline uint64_t load_le(const uint8_t *in, size_t bytes)
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            value |= static_cast<uint64_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    /*
+     * CaptureWriter - Appends records to a capture file through a large stdio buffer.
+     * Thread-safe: RX and TX may be logged from different threads.
+     */
+    class CaptureWriter
+    {
+    private:
+        std::FILE *file_ = nullptr;
+        std::mutex mutex_;
+        uint64_t bytes_written_ = 0;
+        uint64_t records_ = 0;
+
+    public:
+        CaptureWriter() = default;
+        ~CaptureWriter() { close(); }
+
+        CaptureWriter(const CaptureWriter &) = delete;
+        CaptureWriter &operator=(const CaptureWriter &) = delete;
+
+        // Create (truncate) a capture file and write its header. Returns true on success.
+        bool open(const char *path, size_t buffer_size = 1 << 20)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (file_ != nullptr)
+            {
+                return false;
+            }
+            file_ = std::fopen(path, "wb");
+            if (file_ == nullptr)
+            {
+                return false;
+            }
+            std::setvbuf(file_, nullptr, _IOFBF, buffer_size);
+
+            uint8_t header[FILE_HEADER_SIZE] = {};
+            std::memcpy(header, FILE_MAGIC, sizeof(FILE_MAGIC));
+            store_le(header + 8, FILE_VERSION, 4);
+            bytes_written_ = std::fwrite(header, 1, sizeof(header), file_);
+            records_ = 0;
+            return bytes_written_ == sizeof(header);
+        }
+
+        void close()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (file_ != nullptr)
+            {
+                std::fclose(file_);
+                file_ = nullptr;
+            }
+        }
+
+        // Append a chunk. Returns false if the file is not open or the write failed.
+        bool write(Direction direction, const uint8_t *data, size_t size, uint64_t timestamp_us)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (file_ == nullptr)
+            {
+                return false;
+            }
+            do
+            {
+                size_t part = size < MAX_RECORD_DATA ? size : MAX_RECORD_DATA;
+                uint8_t header[RECORD_HEADER_SIZE] = {};
+                store_le(header, timestamp_us, 8);
+                header[8] = static_cast<uint8_t>(direction);
+                store_le(header + 10, part, 2);
+                if (std::fwrite(header, 1, sizeof(header), file_) != sizeof(header) ||
+                    std::fwrite(data, 1, part, file_) != part)
+                {
+                    return false;
+                }
+                bytes_written_ += sizeof(header) + part;
+                ++records_;
+                data += part;
+                size -= part;
+            } while (size > 0);
+            return true;
+        }
+
+        bool flush()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return file_ != nullptr && std::fflush(file_) == 0;
+        }
+
+        bool is_open() const { return file_ != nullptr; }
+        uint64_t bytes_written() const { return bytes_written_; }
+        uint64_t records() const { return records_; }
+    };
+
+    /*
+     * CaptureUart - Transparent tap: forwards every call to the wrapped driver and records the traffic.
+     */
+    template <typename UartT>
+    class CaptureUart final : public Uart
+    {
+        static_assert(is_uart_transport<UartT>::value, "UartT must provide init(), deinit(), send_data() and receive_data()");
+
+    private:
+        UartT &uart_;
+        CaptureWriter &writer_;
+
+    public:
+        CaptureUart(UartT &uart, CaptureWriter &writer) : uart_(uart), writer_(writer) {}
+
+        bool init() override { return uart_.init(); }
+        void deinit() override { uart_.deinit(); }
+
+        // Only writes the driver accepted are recorded: a replay must not show frames that never reached the wire
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            uint64_t timestamp_us = timing::get_tick_us64();
+            if (!uart_send_data(uart_, data, size))
+            {
+                return false;
+            }
+            if (size > 0)
+            {
+                writer_.write(Direction::Tx, data, size, timestamp_us);
+            }
+            return true;
+        }
+
+        size_t receive_data(uint8_t *out_buffer, size_t max_bytes) override
+        {
+            size_t n = uart_receive_data(uart_, out_buffer, max_bytes);
+            if (n > 0)
+            {
+                writer_.write(Direction::Rx, out_buffer, n, timing::get_tick_us64());
+            }
+            return n;
+        }
+
+        UartT &uart() { return uart_; }
+    };
+
+    /*
+     * CaptureReader - Sequential, zero-copy iteration over a capture held in memory.
+     */
+    class CaptureReader
+    {
+    private:
+        const uint8_t *data_;
+        size_t size_;
+        size_t offset_ = FILE_HEADER_SIZE;
+        bool valid_;
+
+    public:
+        CaptureReader(const uint8_t *data, size_t size)
+            : data_(data), size_(size),
+              valid_(size >= FILE_HEADER_SIZE && std::memcmp(data, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0 &&
+                     load_le(data + 8, 4) == FILE_VERSION)
+        {
+        }
+
+        // True if the buffer starts with a supported capture header
+        bool valid() const { return valid_; }
+
+        // Read the next record. Returns false at the end (a truncated last record is ignored).
+        bool next(Record &record)
+        {
+            if (!valid_ || offset_ + RECORD_HEADER_SIZE > size_)
+            {
+                return false;
+            }
+            const uint8_t *header = data_ + offset_;
+            size_t length = static_cast<size_t>(load_le(header + 10, 2));
+            if (offset_ + RECORD_HEADER_SIZE + length > size_)
+            {
+                return false;
+            }
+            record.timestamp_us = load_le(header, 8);
+            record.direction = static_cast<Direction>(header[8]);
+            record.data = header + RECORD_HEADER_SIZE;
+            record.size = length;
+            offset_ += RECORD_HEADER_SIZE + length;
+            return true;
+        }
+
+        void rewind() { offset_ = FILE_HEADER_SIZE; }
+
+        const uint8_t *data() const { return data_; }
+        size_t size() const { return size_; }
+    };
+} // namespace uart_protocol::capture
@@ -0,0 +1,358 @@
+#pragma once
+#include "ProtocolConfig.hpp"
+#include "frame_utility.hpp"
+#include "protocol.hpp"
+#include "timing_utility.hpp"
+#include "tx_scheduler.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/*
+ * Channel Mux - Logical channels over one link with credit-based flow control.
+ *
+ * Independent streams (telemetry, commands, logs, firmware update) share one UART without sharing
+ * buffers: every channel has its own TX queue on the sender and its own receive window on the receiver.
+ *
+ * Wire format:
+ *   CHANNEL_DATA_TYPE payload: [channel (1 byte)] + [sequence (1 byte)] + [data]
+ *   CREDIT_TYPE payload:       { [channel (1 byte)] + [limit (2 bytes, LE)] + [expected sequence (1 byte)] } * N
+ *
+ * Credits are counted in frames. The receiver advertises an absolute limit per channel
+ * (frames released by the application + window), the sender may transmit while its sent counter is
+ * below the limit. A lost CREDIT frame is therefore repaired by any later one, and all windows are
+ * re-advertised every config::MUX_CREDIT_REFRESH_MS. The sequence byte lets the receiver count frames
+ * lost on the wire as released, so corrupted frames do not leak credits.
+ *
+ * Lost tail frames (no later frame reveals the gap) are resynced through the expected sequence in each
+ * CREDIT entry: once a channel has sent nothing for config::MUX_CREDIT_REFRESH_MS, nothing it sent can
+ * still be on the wire, so frames the receiver has not seen were lost. The sender extends its limit by
+ * that many frames; the receiver releases them when the next frame shows the gap. A channel that lost
+ * its whole window therefore recovers with the next refresh instead of stalling for good.
+ *
+ * A slow consumer only exhausts the credits of its own channel: its sender queue fills up
+ * (TxStatus::QueueFull) while the other channels keep flowing. The receiver never buffers more than
+ * Window frames per channel.
+ *
+ * Frames go out through protocol.send_frame(). Bind the protocol to a ScheduledUart (tx_scheduler.hpp)
+ * to send CREDIT frames in the control class, ahead of queued channel data.
+ *
+ * Both ends must use the same Window (initial credits). Not internally synchronized.
+ *
+ * Usage:
+ *   uart_protocol::ChannelMux<MyUart> mux(protocol);
+ *   mux.send(LOG_CHANNEL, data, len);                       // queue on one channel
+ *   decoder.feed(rx, n, [&](const uart_protocol::FrameView &frame) { mux.on_frame(frame); });
+ *   mux.poll();                                             // transmit queued frames, grant credits
+ *   size_t n = mux.receive(LOG_CHANNEL, buffer, sizeof(buffer));
+ */
+
+namespace uart_protocol
+{
+    // Largest data block per channel frame (channel and sequence bytes take 2 bytes of the payload)
+    inline constexpr size_t MUX_MAX_DATA_SIZE = config::MAX_PAYLOAD_SIZE - 2;
+
+    template <typename UartT, size_t Channels = config::MUX_CHANNELS, size_t Window = config::MUX_RX_WINDOW,
+              size_t TxDepth = config::MUX_TX_QUEUE_DEPTH>
+    class ChannelMux
+    {
+        static_assert(Channels > 0 && Channels <= 63, "Channels must be in [1, 63] (all grants fit in one CREDIT frame)");
+        static_assert(Window > 0 && Window < 128, "Window must be in [1, 127] (1-byte sequence numbers)");
+        static_assert(TxDepth > 0, "TxDepth must be at least 1");
+
+    private:
+        static constexpr uint16_t GRANT_THRESHOLD = Window / 2 > 0 ? Window / 2 : 1;
+        static constexpr size_t CREDIT_ENTRY_SIZE = 4; // [channel][limit LE16][expected sequence]
+
+        struct Slot
+        {
+            uint8_t size = 0;
+            uint8_t data[MUX_MAX_DATA_SIZE];
+        };
+
+        struct TxChannel
+        {
+            Slot slots[TxDepth];
+            size_t head = 0;
+            size_t count = 0;
+            uint16_t sent = 0;            // Frames transmitted (wraps)
+            uint16_t limit = Window;      // Peer's advertised limit
+            uint8_t sequence = 0;
+            uint32_t last_sent_ms = 0;    // When the last frame of this channel was written
+            uint64_t rejected = 0;
+        };
+
+        struct RxChannel
+        {
+            Slot slots[Window];
+            size_t head = 0;
+            size_t count = 0;
+            uint16_t released = 0;        // Frames consumed by the application or lost on the wire (wraps)
+            uint16_t advertised = Window; // Last limit sent to the peer
+            uint8_t expected = 0;         // Next expected sequence number
+            uint64_t lost = 0;
+            uint64_t overruns = 0;
+        };
+
+        BasicProtocol<UartT> &protocol_;
+        TxChannel tx_[Channels];
+        RxChannel rx_[Channels];
+        size_t next_channel_ = 0; // Round-robin start for poll()
+        uint32_t last_refresh_ms_;
+
+        uint16_t limit_of(const RxChannel &rx) const
+        {
+            return static_cast<uint16_t>(rx.released + Window);
+        }
+
+        // Send the head frame of a channel if the peer granted a credit
+        bool transmit_one(uint8_t channel)
+        {
+            TxChannel &tx = tx_[channel];
+            if (tx.count == 0 || static_cast<int16_t>(tx.limit - tx.sent) <= 0)
+            {
+                return false;
+            }
+
+            const Slot &slot = tx.slots[tx.head];
+            uint8_t payload[config::MAX_PAYLOAD_SIZE];
+            payload[0] = channel;
+            payload[1] = tx.sequence;
+            std::memcpy(payload + 2, slot.data, slot.size);
+            if (!protocol_.send_frame(config::CHANNEL_DATA_TYPE, payload, slot.size + 2u))
+            {
+                return false; // Driver refused: keep the frame queued
+            }
+
+            tx.head = (tx.head + 1) % TxDepth;
+            --tx.count;
+            ++tx.sent;
+            ++tx.sequence;
+            tx.last_sent_ms = timing::get_tick_ms();
+            return true;
+        }
+
+        // Send one CREDIT frame for every channel whose limit moved by the grant threshold (all channels if refresh)
+        bool send_credits(bool refresh)
+        {
+            uint8_t payload[Channels * CREDIT_ENTRY_SIZE];
+            size_t len = 0;
+            for (size_t channel = 0; channel < Channels; ++channel)
+            {
+                RxChannel &rx = rx_[channel];
+                uint16_t limit = limit_of(rx);
+                if (!refresh && static_cast<uint16_t>(limit - rx.advertised) < GRANT_THRESHOLD)
+                {
+                    continue;
+                }
+                payload[len++] = static_cast<uint8_t>(channel);
+                payload[len++] = static_cast<uint8_t>(limit & 0xFF);
+                payload[len++] = static_cast<uint8_t>(limit >> 8);
+                payload[len++] = rx.expected;
+            }
+            if (len == 0)
+            {
+                return false;
+            }
+            if (!protocol_.send_frame(config::CREDIT_TYPE, payload, len))
+            {
+                return false;
+            }
+            for (size_t i = 0; i < len; i += CREDIT_ENTRY_SIZE)
+            {
+                rx_[payload[i]].advertised = static_cast<uint16_t>(payload[i + 1] | (payload[i + 2] << 8));
+            }
+            return true;
+        }
+
+        void on_channel_data(const uint8_t *payload, size_t len)
+        {
+            uint8_t channel = payload[0];
+            RxChannel &rx = rx_[channel];
+
+            // Frames skipped by the sequence were lost on the wire: release their credits
+            uint8_t gap = static_cast<uint8_t>(payload[1] - rx.expected);
+            if (gap >= 128)
+            {
+                return; // Duplicate or stale frame
+            }
+            rx.lost += gap;
+            rx.released = static_cast<uint16_t>(rx.released + gap);
+            rx.expected = static_cast<uint8_t>(payload[1] + 1);
+
+            if (rx.count == Window)
+            {
+                // Peer sent without credit: drop, but keep the window accounting consistent
+                ++rx.overruns;
+                ++rx.released;
+                return;
+            }
+            Slot &slot = rx.slots[(rx.head + rx.count) % Window];
+            slot.size = static_cast<uint8_t>(len - 2);
+            std::memcpy(slot.data, payload + 2, len - 2);
+            ++rx.count;
+        }
+
+        void on_credit(const uint8_t *payload, size_t len)
+        {
+            for (size_t i = 0; i + CREDIT_ENTRY_SIZE <= len; i += CREDIT_ENTRY_SIZE)
+            {
+                if (payload[i] >= Channels)
+                {
+                    continue;
+                }
+                TxChannel &tx = tx_[payload[i]];
+                uint16_t limit = static_cast<uint16_t>(payload[i + 1] | (payload[i + 2] << 8));
+
+                // Quiet for a refresh period: frames the receiver has not seen were lost, not in flight
+                uint8_t missing = static_cast<uint8_t>(tx.sequence - payload[i + 3]);
+                if (missing > 0 && missing < 128 && timing::has_elapsed(tx.last_sent_ms, config::MUX_CREDIT_REFRESH_MS))
+                {
+                    limit = static_cast<uint16_t>(limit + missing);
+                }
+
+                // Limits only grow: an older CREDIT frame never takes back credit
+                if (static_cast<int16_t>(limit - tx.limit) > 0)
+                {
+                    tx.limit = limit;
+                }
+            }
+        }
+
+    public:
+        explicit ChannelMux(BasicProtocol<UartT> &protocol) : protocol_(protocol), last_refresh_ms_(timing::get_tick_ms()) {}
+
+        ChannelMux(const ChannelMux &) = delete;
+        ChannelMux &operator=(const ChannelMux &) = delete;
+
+        /*
+         * Queue data on a channel and transmit it right away if the channel has credit.
+         * @param channel Channel number (< Channels).
+         * @param data Data bytes (at most MUX_MAX_DATA_SIZE).
+         * @param len Number of data bytes.
+         * @return Queued, QueueFull if this channel's queue is full (backpressure), PayloadTooLarge otherwise.
+         */
+        TxStatus send(uint8_t channel, const uint8_t *data, size_t len)
+        {
+            if (channel >= Channels || len > MUX_MAX_DATA_SIZE)
+            {
+                return TxStatus::PayloadTooLarge;
+            }
+            TxChannel &tx = tx_[channel];
+            if (tx.count == TxDepth)
+            {
+                ++tx.rejected;
+                return TxStatus::QueueFull;
+            }
+            Slot &slot = tx.slots[(tx.head + tx.count) % TxDepth];
+            slot.size = static_cast<uint8_t>(len);
+            if (len > 0)
+            {
+                std::memcpy(slot.data, data, len);
+            }
+            ++tx.count;
+
+            if (tx.count == 1)
+            {
+                transmit_one(channel);
+            }
+            return TxStatus::Queued;
+        }
+
+        // Feed a received frame. Returns true if it was a CHANNEL_DATA or CREDIT frame for this mux.
+        bool on_frame(uint8_t type, const uint8_t *payload, size_t len)
+        {
+            if (type == config::CHANNEL_DATA_TYPE)
+            {
+                if (len < 2 || payload[0] >= Channels)
+                {
+                    return false;
+                }
+                on_channel_data(payload, len);
+                return true;
+            }
+            if (type == config::CREDIT_TYPE)
+            {
+                on_credit(payload, len);
+                return true;
+            }
+            return false;
+        }
+
+        bool on_frame(const FrameView &frame) { return on_frame(frame.type, frame.payload, frame.payload_size); }
+        bool on_frame(const Frame &frame) { return on_frame(frame.type, frame.payload.data(), frame.payload.size()); }
+
+        /*
+         * Take the oldest received frame of a channel. Frees one slot of the receive window.
+         * @param channel Channel number (< Channels).
+         * @param out Destination buffer (MUX_MAX_DATA_SIZE bytes always suffice).
+         * @param max_bytes Size of out. Longer frames are truncated.
+         * @return Number of bytes copied, 0 if nothing is pending (check available() for empty frames).
+         */
+        size_t receive(uint8_t channel, uint8_t *out, size_t max_bytes)
+        {
+            if (channel >= Channels || rx_[channel].count == 0)
+            {
+                return 0;
+            }
+            RxChannel &rx = rx_[channel];
+            const Slot &slot = rx.slots[rx.head];
+            size_t size = slot.size < max_bytes ? slot.size : max_bytes;
+            std::memcpy(out, slot.data, size);
+            rx.head = (rx.head + 1) % Window;
+            --rx.count;
+            ++rx.released;
+            return size;
+        }
+
+        /*
+         * Transmit queued frames (round-robin across channels with credit) and grant released credits.
+         * Call from the TX loop after feeding received frames.
+         * @return Number of frames written (data and credit frames).
+         */
+        size_t poll()
+        {
+            size_t sent = 0;
+            bool progress = true;
+            while (progress)
+            {
+                progress = false;
+                for (size_t i = 0; i < Channels; ++i)
+                {
+                    uint8_t channel = static_cast<uint8_t>((next_channel_ + i) % Channels);
+                    if (transmit_one(channel))
+                    {
+                        ++sent;
+                        progress = true;
+                    }
+                }
+            }
+            next_channel_ = (next_channel_ + 1) % Channels;
+
+            bool refresh = timing::has_elapsed(last_refresh_ms_, config::MUX_CREDIT_REFRESH_MS);
+            if (refresh)
+            {
+                last_refresh_ms_ = timing::get_tick_ms();
+            }
+            if (send_credits(refresh))
+            {
+                ++sent;
+            }
+            return sent;
+        }
+
+        // Frames the sender may still transmit on a channel before waiting for credit
+        size_t credits(uint8_t channel) const
+        {
+            int16_t credits = static_cast<int16_t>(tx_[channel].limit - tx_[channel].sent);
+            return credits > 0 ? static_cast<size_t>(credits) : 0;
+        }
+        size_t queued(uint8_t channel) const { return tx_[channel].count; }
+        size_t free_slots(uint8_t channel) const { return TxDepth - tx_[channel].count; }
+        uint64_t rejected(uint8_t channel) const { return tx_[channel].rejected; }
+
+        size_t available(uint8_t channel) const { return rx_[channel].count; }
+        uint64_t lost(uint8_t channel) const { return rx_[channel].lost; }
+        uint64_t overruns(uint8_t channel) const { return rx_[channel].overruns; }
+    };
+} // namespace uart_protocol
@@ -0,0 +1,536 @@
+#pragma once
+#include "peripheral.hpp"
+#include "ProtocolConfig.hpp"
+#include "frame_utility.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/*
+ * FEC - Reed-Solomon forward error correction per frame.
+ *
+ * On links where a retransmit is expensive (half-duplex radio bridges), frames carry parity so that
+ * a few corrupted bytes are repaired by the receiver instead of being rejected by the CRC.
+ *
+ * FEC frame on the wire:
+ *   [START_WORD (2 bytes)] + [LEN (1 byte)] + [LEN parity (2 bytes)] +
+ *   { [block of TYPE + PAYLOAD + CRC16 (up to Block bytes)] + [parity (Parity bytes)] } * N
+ *
+ * The body (TYPE, payload and the usual CRC16) is split into blocks of Block bytes, each protected by
+ * Parity Reed-Solomon parity bytes over GF(256), so every block corrects up to Parity / 2 bad bytes.
+ * LEN has its own 2 parity bytes (corrects one bad byte). After correction the CRC16 is still checked,
+ * so a miscorrection is never delivered. Bit errors inside the START_WORD still lose the frame.
+ *
+ * Table-driven (constexpr GF(256) log/exp tables), no allocation, encode/decode work on caller buffers.
+ *
+ * FecUart wraps a driver so an unchanged BasicProtocol runs over the FEC link: every frame written
+ * by the protocol is re-encoded with parity, received FEC frames are corrected and handed back as
+ * plain frames. Both ends must use the same Parity and Block.
+ *
+ * Usage:
+ *   uart_protocol::FecUart<MyUart> fec(my_uart); // config::FEC_PARITY_BYTES / config::FEC_BLOCK_SIZE
+ *   uart_protocol::BasicProtocol<decltype(fec)> protocol(fec);
+ */
+
+namespace uart_protocol
+{
+    // GF(256) log/exp tables for the primitive polynomial x^8 + x^4 + x^3 + x^2 + 1 (0x11D)
+    struct Gf256Tables
+    {
+        uint8_t exp[512]; // Doubled so that exp[log a + log b] needs no modulo
+        uint8_t log[256];
+        constexpr Gf256Tables() : exp(), log()
+        {
+            uint16_t x = 1;
+            for (int i = 0; i < 255; ++i)
+            {
+                exp[i] = static_cast<uint8_t>(x);
+                log[x] = static_cast<uint8_t>(i);
+                x = static_cast<uint16_t>(x << 1);
+                if (x & 0x100)
+                {
+                    x ^= 0x11D;
+                }
+            }
+            for (int i = 255; i < 512; ++i)
+            {
+                exp[i] = exp[i - 255];
+            }
+        }
+    };
+
+    inline constexpr Gf256Tables GF256_TABLES{};
+
+    // GF(256) arithmetic
+    struct Gf256
+    {
+        static uint8_t mul(uint8_t a, uint8_t b)
+        {
+            return (a == 0 || b == 0) ? 0 : GF256_TABLES.exp[GF256_TABLES.log[a] + GF256_TABLES.log[b]];
+        }
+
+        static uint8_t div(uint8_t a, uint8_t b) // b != 0
+        {
+            return a == 0 ? 0 : GF256_TABLES.exp[GF256_TABLES.log[a] + 255 - GF256_TABLES.log[b]];
+        }
+
+        static uint8_t pow_alpha(int power) // alpha^power, power >= 0
+        {
+            return GF256_TABLES.exp[power % 255];
+        }
+    };
+
+    // Generator polynomial of a Reed-Solomon code with Parity roots alpha^0 .. alpha^(Parity-1)
+    template <size_t Parity>
+    struct ReedSolomonGenerator
+    {
+        uint8_t coef[Parity + 1]; // coef[i] multiplies x^i, coef[Parity] == 1
+        constexpr ReedSolomonGenerator() : coef()
+        {
+            coef[0] = 1;
+            for (size_t root = 0; root < Parity; ++root)
+            {
+                // Multiply by (x + alpha^root)
+                uint8_t alpha = GF256_TABLES.exp[root];
+                for (size_t i = root + 1; i > 0; --i)
+                {
+                    uint8_t scaled = (coef[i] == 0) ? 0 : GF256_TABLES.exp[GF256_TABLES.log[coef[i]] + GF256_TABLES.log[alpha]];
+                    coef[i] = static_cast<uint8_t>(coef[i - 1] ^ scaled);
+                }
+                coef[0] = (coef[0] == 0) ? 0 : GF256_TABLES.exp[GF256_TABLES.log[coef[0]] + GF256_TABLES.log[alpha]];
+            }
+        }
+    };
+
+    /*
+     * Systematic Reed-Solomon code with Parity check symbols (generator roots alpha^0 .. alpha^(Parity-1)).
+     * Codewords are shortened: any length n = k + Parity <= 255 is accepted.
+     */
+    template <size_t Parity>
+    class ReedSolomon
+    {
+        static_assert(Parity >= 2 && Parity % 2 == 0 && Parity < 255, "Parity must be even and in [2, 254]");
+
+    private:
+        static constexpr ReedSolomonGenerator<Parity> generator{};
+
+    public:
+        /*
+         * Compute the parity of a data block.
+         * @param data Data bytes (k <= 255 - Parity).
+         * @param k Number of data bytes.
+         * @param parity Receives Parity bytes, to be sent right after the data.
+         */
+        static void encode(const uint8_t *data, size_t k, uint8_t *parity)
+        {
+            std::memset(parity, 0, Parity);
+            for (size_t i = 0; i < k; ++i)
+            {
+                uint8_t feedback = static_cast<uint8_t>(data[i] ^ parity[0]);
+                std::memmove(parity, parity + 1, Parity - 1);
+                parity[Parity - 1] = 0;
+                if (feedback != 0)
+                {
+                    for (size_t j = 0; j < Parity; ++j)
+                    {
+                        parity[j] ^= Gf256::mul(feedback, generator.coef[Parity - 1 - j]);
+                    }
+                }
+            }
+        }
+
+        /*
+         * Correct a received codeword in place.
+         * @param codeword Data bytes followed by Parity parity bytes.
+         * @param n Codeword length (Parity < n <= 255).
+         * @return Number of corrected bytes, -1 if there are more errors than the code can correct.
+         */
+        static int decode(uint8_t *codeword, size_t n)
+        {
+            // Syndromes S_j = c(alpha^j)
+            uint8_t syndromes[Parity];
+            bool clean = true;
+            for (size_t j = 0; j < Parity; ++j)
+            {
+                uint8_t alpha = GF256_TABLES.exp[j];
+                uint8_t s = 0;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    s = static_cast<uint8_t>(Gf256::mul(s, alpha) ^ codeword[i]);
+                }
+                syndromes[j] = s;
+                clean = clean && s == 0;
+            }
+            if (clean)
+            {
+                return 0;
+            }
+
+            // Berlekamp-Massey: error locator polynomial lambda
+            uint8_t lambda[Parity + 1] = {1};
+            uint8_t previous[Parity + 1] = {1};
+            size_t errors = 0;
+            size_t shift = 1;
+            uint8_t previous_discrepancy = 1;
+            for (size_t step = 0; step < Parity; ++step)
+            {
+                uint8_t discrepancy = syndromes[step];
+                for (size_t i = 1; i <= errors; ++i)
+                {
+                    discrepancy ^= Gf256::mul(lambda[i], syndromes[step - i]);
+                }
+                if (discrepancy == 0)
+                {
+                    ++shift;
+                    continue;
+                }
+                uint8_t scale = Gf256::div(discrepancy, previous_discrepancy);
+                uint8_t saved[Parity + 1];
+                std::memcpy(saved, lambda, sizeof(lambda));
+                for (size_t i = 0; i + shift <= Parity; ++i)
+                {
+                    lambda[i + shift] ^= Gf256::mul(scale, previous[i]);
+                }
+                if (2 * errors <= step)
+                {
+                    errors = step + 1 - errors;
+                    std::memcpy(previous, saved, sizeof(previous));
+                    previous_discrepancy = discrepancy;
+                    shift = 1;
+                }
+                else
+                {
+                    ++shift;
+                }
+            }
+            if (errors > Parity / 2)
+            {
+                return -1;
+            }
+
+            // Chien search over the n positions of the (shortened) codeword
+            size_t positions[Parity / 2];
+            size_t found = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                size_t degree = n - 1 - i;
+                int inverse = static_cast<int>((255 - degree % 255) % 255); // log of alpha^-degree
+                uint8_t value = 0;
+                for (size_t k = 0; k <= errors; ++k)
+                {
+                    value ^= Gf256::mul(lambda[k], Gf256::pow_alpha(inverse * static_cast<int>(k)));
+                }
+                if (value == 0)
+                {
+                    if (found == errors)
+                    {
+                        return -1;
+                    }
+                    positions[found++] = i;
+                }
+            }
+            if (found != errors)
+            {
+                return -1;
+            }
+
+            // Forney: omega = S * lambda mod x^Parity, e = X * omega(X^-1) / lambda'(X^-1)
+            uint8_t omega[Parity] = {};
+            for (size_t i = 0; i < Parity; ++i)
+            {
+                for (size_t k = 0; k <= i && k <= errors; ++k)
+                {
+                    omega[i] ^= Gf256::mul(lambda[k], syndromes[i - k]);
+                }
+            }
+            for (size_t e = 0; e < found; ++e)
+            {
+                size_t degree = n - 1 - positions[e];
+                int inverse = static_cast<int>((255 - degree % 255) % 255);
+                uint8_t numerator = 0;
+                for (size_t i = 0; i < Parity; ++i)
+                {
+                    numerator ^= Gf256::mul(omega[i], Gf256::pow_alpha(inverse * static_cast<int>(i)));
+                }
+                uint8_t derivative = 0;
+                for (size_t k = 1; k <= errors; k += 2)
+                {
+                    derivative ^= Gf256::mul(lambda[k], Gf256::pow_alpha(inverse * static_cast<int>(k - 1)));
+                }
+                if (derivative == 0)
+                {
+                    return -1;
+                }
+                uint8_t magnitude = Gf256::mul(Gf256::pow_alpha(static_cast<int>(degree)), Gf256::div(numerator, derivative));
+                codeword[positions[e]] ^= magnitude;
+            }
+            return static_cast<int>(found);
+        }
+    };
+
+    template <size_t Parity = config::FEC_PARITY_BYTES, size_t Block = config::FEC_BLOCK_SIZE>
+    class FecCodec
+    {
+        static_assert(Block > 0 && Block + Parity <= 255, "Block + Parity must fit one Reed-Solomon codeword (255 bytes)");
+
+    private:
+        using BodyCode = ReedSolomon<Parity>;
+        using HeaderCode = ReedSolomon<2>;
+
+        static constexpr size_t HEADER_SIZE = 5; // START_WORD, LEN, 2 LEN parity bytes
+
+        static constexpr size_t body_size(size_t payload_len)
+        {
+            size_t data = payload_len + 3; // TYPE + payload + CRC16
+            return data + ((data + Block - 1) / Block) * Parity;
+        }
+
+    public:
+        // Size of an FEC frame carrying payload_len bytes
+        static constexpr size_t encoded_size(size_t payload_len)
+        {
+            return HEADER_SIZE + body_size(payload_len);
+        }
+
+        static constexpr size_t MAX_ENCODED_SIZE = HEADER_SIZE + ((255 + 3) + ((255 + 3 + Block - 1) / Block) * Parity);
+
+        /*
+         * Encode a frame with parity into a caller-provided buffer (no allocation).
+         * @param out At least encoded_size(payload_len) bytes.
+         * @return Encoded size, 0 if payload_len > 255.
+         */
+        static size_t encode(uint8_t type, const uint8_t *payload, size_t payload_len, uint8_t *out)
+        {
+            // Build the plain frame first, its CRC16 is kept inside the protected body
+            uint8_t frame[MAX_FRAME_SIZE];
+            size_t frame_size = encode_frame(type, payload, payload_len, frame);
+            if (frame_size == 0)
+            {
+                return 0;
+            }
+
+            out[0] = frame[0];
+            out[1] = frame[1];
+            out[2] = frame[2];
+            HeaderCode::encode(out + 2, 1, out + 3);
+
+            size_t offset = HEADER_SIZE;
+            const uint8_t *body = frame + 3;
+            size_t remaining = frame_size - 3;
+            while (remaining > 0)
+            {
+                size_t chunk = remaining < Block ? remaining : Block;
+                std::memcpy(out + offset, body, chunk);
+                BodyCode::encode(body, chunk, out + offset + chunk);
+                offset += chunk + Parity;
+                body += chunk;
+                remaining -= chunk;
+            }
+            return offset;
+        }
+
+        /*
+         * Correct and decode the FEC frame at the start of a raw buffer.
+         * @param data Buffer that should start with an FEC frame (it is not modified).
+         * @param len Bytes available in the buffer.
+         * @param frame_out MAX_FRAME_SIZE bytes receiving the corrected plain frame; out_frame points into it.
+         * @param out_frame View of the corrected frame on ParseStatus::Ok.
+         * @param consumed_bytes Ok: FEC frame size. Invalid: bytes to drop before the next START_WORD candidate. Otherwise 0.
+         * @param corrected_bytes Number of bytes repaired on ParseStatus::Ok.
+         */
+        static ParseStatus decode(const uint8_t *data, size_t len, uint8_t *frame_out, FrameView &out_frame,
+                                  size_t &consumed_bytes, size_t &corrected_bytes)
+        {
+            consumed_bytes = 0;
+            corrected_bytes = 0;
+
+            uint16_t start_word = len >= 2 ? static_cast<uint16_t>(data[0]) | (static_cast<uint16_t>(data[1]) << 8) : 0;
+            if ((len >= 2 && start_word != Frame::START_WORD) ||
+                (len == 1 && data[0] != static_cast<uint8_t>(Frame::START_WORD & 0xFF)))
+            {
+                consumed_bytes = find_start_word(data, len, 1);
+                return ParseStatus::Invalid;
+            }
+            if (len < HEADER_SIZE)
+            {
+                return ParseStatus::NeedMoreData;
+            }
+
+            uint8_t header[3] = {data[2], data[3], data[4]};
+            int fixed = HeaderCode::decode(header, sizeof(header));
+            if (fixed < 0)
+            {
+                consumed_bytes = find_start_word(data, len, 1);
+                return ParseStatus::Invalid;
+            }
+
+            size_t payload_len = header[0];
+            size_t total = encoded_size(payload_len);
+            if (len < total)
+            {
+                return ParseStatus::NeedMoreData;
+            }
+
+            frame_out[0] = data[0];
+            frame_out[1] = data[1];
+            frame_out[2] = header[0];
+            size_t corrected = static_cast<size_t>(fixed);
+
+            size_t offset = HEADER_SIZE;
+            size_t out_offset = 3;
+            size_t remaining = payload_len + 3;
+            while (remaining > 0)
+            {
+                size_t chunk = remaining < Block ? remaining : Block;
+                uint8_t codeword[Block + Parity];
+                std::memcpy(codeword, data + offset, chunk + Parity);
+                int block_fixed = BodyCode::decode(codeword, chunk + Parity);
+                if (block_fixed < 0)
+                {
+                    consumed_bytes = find_start_word(data, len, 1);
+                    return ParseStatus::Invalid;
+                }
+                corrected += static_cast<size_t>(block_fixed);
+                std::memcpy(frame_out + out_offset, codeword, chunk);
+                offset += chunk + Parity;
+                out_offset += chunk;
+                remaining -= chunk;
+            }
+
+            // The CRC16 rejects anything the code miscorrected
+            size_t frame_consumed = 0;
+            if (decode_frame(frame_out, out_offset, out_frame, frame_consumed) != ParseStatus::Ok)
+            {
+                consumed_bytes = find_start_word(data, len, 1);
+                return ParseStatus::Invalid;
+            }
+            consumed_bytes = total;
+            corrected_bytes = corrected;
+            return ParseStatus::Ok;
+        }
+    };
+
+    template <typename UartT, size_t Parity = config::FEC_PARITY_BYTES, size_t Block = config::FEC_BLOCK_SIZE>
+    class FecUart final : public Uart
+    {
+        static_assert(is_uart_transport<UartT>::value, "UartT must provide init(), deinit(), send_data() and receive_data()");
+
+    public:
+        using Codec = FecCodec<Parity, Block>;
+
+    private:
+        UartT &uart_;
+
+        uint8_t rx_[2 * Codec::MAX_ENCODED_SIZE]; // Raw FEC bytes not decoded yet
+        size_t rx_size_ = 0;
+        uint8_t ready_[MAX_FRAME_SIZE]; // Corrected plain frame not yet returned to the caller
+        size_t ready_size_ = 0;
+        size_t ready_offset_ = 0;
+
+        uint64_t frames_ = 0;
+        uint64_t corrected_frames_ = 0;
+        uint64_t corrected_bytes_ = 0;
+        uint64_t skipped_bytes_ = 0;
+
+        // Decode the next FEC frame from rx_ into ready_. Returns false if more input is needed.
+        bool decode_next()
+        {
+            size_t offset = 0;
+            bool decoded = false;
+            while (offset < rx_size_ && !decoded)
+            {
+                FrameView frame;
+                size_t consumed = 0;
+                size_t corrected = 0;
+                ParseStatus status = Codec::decode(rx_ + offset, rx_size_ - offset, ready_, frame, consumed, corrected);
+                if (status == ParseStatus::NeedMoreData)
+                {
+                    break;
+                }
+                if (status == ParseStatus::Ok)
+                {
+                    ready_size_ = FRAME_OVERHEAD + frame.payload_size;
+                    ready_offset_ = 0;
+                    ++frames_;
+                    if (corrected > 0)
+                    {
+                        ++corrected_frames_;
+                        corrected_bytes_ += corrected;
+                    }
+                    decoded = true;
+                }
+                else
+                {
+                    skipped_bytes_ += consumed;
+                }
+                offset += consumed;
+            }
+            std::memmove(rx_, rx_ + offset, rx_size_ - offset);
+            rx_size_ -= offset;
+            return decoded;
+        }
+
+    public:
+        explicit FecUart(UartT &uart) : uart_(uart) {}
+
+        bool init() override { return uart_.init(); }
+        void deinit() override { uart_.deinit(); }
+
+        // Re-encode every frame in the buffer with parity. Bytes that are not a complete frame are rejected.
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            size_t offset = 0;
+            while (offset < size)
+            {
+                FrameView frame;
+                size_t consumed = 0;
+                if (decode_frame(data + offset, size - offset, frame, consumed) != ParseStatus::Ok)
+                {
+                    return false;
+                }
+                uint8_t encoded[Codec::MAX_ENCODED_SIZE];
+                size_t encoded_size = Codec::encode(frame.type, frame.payload, frame.payload_size, encoded);
+                if (!uart_send_data(uart_, encoded, encoded_size))
+                {
+                    return false;
+                }
+                offset += consumed;
+            }
+            return true;
+        }
+
+        // Return corrected plain frames, reading and decoding FEC frames from the driver as needed
+        size_t receive_data(uint8_t *out_buffer, size_t max_bytes) override
+        {
+            size_t copied = 0;
+            while (copied < max_bytes)
+            {
+                if (ready_offset_ == ready_size_)
+                {
+                    if (!decode_next())
+                    {
+                        size_t got = uart_receive_data(uart_, rx_ + rx_size_, sizeof(rx_) - rx_size_);
+                        if (got == 0)
+                        {
+                            break;
+                        }
+                        rx_size_ += got;
+                        continue;
+                    }
+                }
+                size_t take = ready_size_ - ready_offset_;
+                take = take < max_bytes - copied ? take : max_bytes - copied;
+                std::memcpy(out_buffer + copied, ready_ + ready_offset_, take);
+                ready_offset_ += take;
+                copied += take;
+            }
+            return copied;
+        }
+
+        uint64_t frames() const { return frames_; }
+        uint64_t corrected_frames() const { return corrected_frames_; } // Frames that would have been retransmitted without FEC
+        uint64_t corrected_bytes() const { return corrected_bytes_; }
+        uint64_t skipped_bytes() const { return skipped_bytes_; }
+        UartT &uart() { return uart_; }
+    };
+} // namespace uart_protocol
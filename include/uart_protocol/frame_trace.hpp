@@ -0,0 +1,282 @@
+#pragma once
+#include "ProtocolConfig.hpp"
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * Frame Trace - Per-frame latency trace points with Chrome/Perfetto trace export.
+ *
+ * With configUSE_TRACING set to 1 the library records a timestamped event at each stage of a frame:
+ *   enqueued      - accepted by TxScheduler / MpscFrameQueue
+ *   encoded       - frame bytes built (header, payload, CRC)
+ *   send_data     - handed to the driver's send_data()
+ *   first_rx_byte - first bytes of a reply / received frame arrived
+ *   parsed        - received frame decoded and CRC checked
+ *   ack_matched   - ACK for the sent frame recognized by send_frame_wait_ack()
+ *
+ * Events carry a frame ID, so one frame (and its ACK round trip) can be followed across stages and
+ * threads. Each thread records into its own lock-free SpscRing (no lock on the recording path, events
+ * are dropped and counted when the ring is full). write_chrome_trace() drains all rings into a JSON
+ * file that chrome://tracing and ui.perfetto.dev open directly: one instant event per trace point and
+ * one async slice per frame ID spanning its first to last event.
+ *
+ * With configUSE_TRACING set to 0 (default) UART_PROTOCOL_TRACE() expands to nothing, no trace
+ * state exists and no code is generated. The recording side needs std::thread_local and std::mutex
+ * (std::chrono platform).
+ *
+ * Usage (-DconfigUSE_TRACING=1 or edit ProtocolConfig.hpp):
+ *   protocol.send_frame_wait_ack(config::DATA_TYPE, payload);
+ *   uart_protocol::trace::write_chrome_trace("uart_trace.json");
+ */
+
+namespace uart_protocol::trace
+{
+    enum class TracePoint : uint8_t
+    {
+        Enqueued,
+        Encoded,
+        SendData,
+        FirstRxByte,
+        Parsed,
+        AckMatched
+    };
+
+    inline constexpr const char *trace_point_name(TracePoint point)
+    {
+        switch (point)
+        {
+        case TracePoint::Enqueued:
+            return "enqueued";
+        case TracePoint::Encoded:
+            return "encoded";
+        case TracePoint::SendData:
+            return "send_data";
+        case TracePoint::FirstRxByte:
+            return "first_rx_byte";
+        case TracePoint::Parsed:
+            return "parsed";
+        case TracePoint::AckMatched:
+            return "ack_matched";
+        }
+        return "unknown";
+    }
+} // namespace uart_protocol::trace
+
+#if configUSE_TRACING
+
+#if !defined(configUSE_STD_CHRONO) || !configUSE_STD_CHRONO
+#error "configUSE_TRACING requires the std::chrono timing platform (configUSE_STD_CHRONO)"
+#endif
+
+#include "spsc_ring.hpp"
+#include "timing_utility.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace uart_protocol::trace
+{
+    // One recorded event (16 bytes in the ring)
+    struct TraceEvent
+    {
+        uint64_t timestamp_us;
+        uint32_t frame_id;
+        uint8_t point;
+        uint8_t type;
+        uint16_t size;
+    };
+    static_assert(sizeof(TraceEvent) == 16, "TraceEvent must stay 16 bytes (ring slots)");
+
+    // Event plus the ID of the thread that recorded it
+    struct TraceRecord
+    {
+        TraceEvent event;
+        uint32_t thread_id;
+    };
+
+    struct ThreadTrace
+    {
+        uint32_t thread_id = 0;
+        std::atomic<uint64_t> dropped{0};
+        SpscRing<config::TRACE_RING_SIZE> ring;
+    };
+
+    // Registry of the per-thread rings. The lock is only taken when a thread records its first event and on export.
+    class TraceRegistry
+    {
+    private:
+        std::mutex mutex_;
+        std::vector<std::shared_ptr<ThreadTrace>> threads_;
+        std::atomic<uint32_t> next_frame_id_{1};
+
+    public:
+        static TraceRegistry &instance()
+        {
+            static TraceRegistry registry;
+            return registry;
+        }
+
+        std::shared_ptr<ThreadTrace> attach()
+        {
+            auto thread = std::make_shared<ThreadTrace>();
+            std::lock_guard<std::mutex> lock(mutex_);
+            thread->thread_id = static_cast<uint32_t>(threads_.size() + 1);
+            threads_.push_back(thread);
+            return thread;
+        }
+
+        uint32_t next_frame_id()
+        {
+            uint32_t id = next_frame_id_.fetch_add(1, std::memory_order_relaxed);
+            return id != 0 ? id : next_frame_id_.fetch_add(1, std::memory_order_relaxed); // 0 means "no frame"
+        }
+
+        // Move every buffered event into `out` (single exporter at a time)
+        void collect(std::vector<TraceRecord> &out)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &thread : threads_)
+            {
+                TraceEvent event;
+                while (thread->ring.pop(reinterpret_cast<uint8_t *>(&event), sizeof(event)) == sizeof(event))
+                {
+                    out.push_back(TraceRecord{event, thread->thread_id});
+                }
+            }
+        }
+
+        uint64_t dropped()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            uint64_t total = 0;
+            for (auto &thread : threads_)
+            {
+                total += thread->dropped.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+    };
+
+    inline ThreadTrace &local_trace()
+    {
+        thread_local std::shared_ptr<ThreadTrace> thread = TraceRegistry::instance().attach();
+        return *thread;
+    }
+
+    // New frame ID for correlating trace points (never 0)
+    inline uint32_t next_frame_id()
+    {
+        return TraceRegistry::instance().next_frame_id();
+    }
+
+    // Record one trace point on the calling thread's ring (lock-free, drops when the ring is full)
+    inline void record(TracePoint point, uint32_t frame_id, uint8_t type, size_t size)
+    {
+        TraceEvent event{timing::get_tick_us64(), frame_id, static_cast<uint8_t>(point), type, static_cast<uint16_t>(size)};
+        ThreadTrace &thread = local_trace();
+        if (thread.ring.push(reinterpret_cast<const uint8_t *>(&event), sizeof(event)) == 0)
+        {
+            thread.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Events lost because a thread's ring was full
+    inline uint64_t dropped_events()
+    {
+        return TraceRegistry::instance().dropped();
+    }
+
+    // Drain all rings, events in timestamp order
+    inline std::vector<TraceRecord> collect()
+    {
+        std::vector<TraceRecord> records;
+        TraceRegistry::instance().collect(records);
+        std::stable_sort(records.begin(), records.end(), [](const TraceRecord &a, const TraceRecord &b)
+                         { return a.event.timestamp_us < b.event.timestamp_us; });
+        return records;
+    }
+
+    /*
+     * Drain all rings and write them as Chrome trace event JSON.
+     * @param file Open output file.
+     * @return Number of trace points written.
+     */
+    inline size_t write_chrome_trace(std::FILE *file)
+    {
+        std::vector<TraceRecord> records = collect();
+
+        std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        bool first = true;
+        for (const auto &record : records)
+        {
+            const TraceEvent &event = record.event;
+            std::fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"uart\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":1,\"tid\":%u,"
+                               "\"args\":{\"frame\":%u,\"type\":%u,\"size\":%u}}",
+                         first ? "" : ",\n", trace_point_name(static_cast<TracePoint>(event.point)),
+                         static_cast<unsigned long long>(event.timestamp_us), record.thread_id,
+                         event.frame_id, event.type, event.size);
+            first = false;
+        }
+
+        // One async slice per frame ID, from its first to its last trace point
+        std::vector<TraceRecord> frames;
+        for (const auto &record : records)
+        {
+            if (record.event.frame_id != 0)
+            {
+                frames.push_back(record);
+            }
+        }
+        std::stable_sort(frames.begin(), frames.end(), [](const TraceRecord &a, const TraceRecord &b)
+                         { return a.event.frame_id < b.event.frame_id; });
+        for (size_t begin = 0; begin < frames.size();)
+        {
+            size_t end = begin;
+            while (end + 1 < frames.size() && frames[end + 1].event.frame_id == frames[begin].event.frame_id)
+            {
+                ++end;
+            }
+            const TraceRecord &head = frames[begin];
+            const TraceRecord &tail = frames[end];
+            for (int phase = 0; phase < 2; ++phase)
+            {
+                const TraceRecord &record = phase == 0 ? head : tail;
+                std::fprintf(file, "%s{\"name\":\"frame type 0x%02X\",\"cat\":\"frame\",\"ph\":\"%s\",\"id\":%u,\"ts\":%llu,\"pid\":1,\"tid\":%u}",
+                             first ? "" : ",\n", head.event.type, phase == 0 ? "b" : "e", head.event.frame_id,
+                             static_cast<unsigned long long>(record.event.timestamp_us), record.thread_id);
+                first = false;
+            }
+            begin = end + 1;
+        }
+
+        std::fprintf(file, "\n]}\n");
+        return records.size();
+    }
+
+    // Write the trace to a file. Returns false if the file cannot be created.
+    inline bool write_chrome_trace(const char *path)
+    {
+        std::FILE *file = std::fopen(path, "w");
+        if (file == nullptr)
+        {
+            return false;
+        }
+        write_chrome_trace(file);
+        return std::fclose(file) == 0;
+    }
+} // namespace uart_protocol::trace
+
+#define UART_PROTOCOL_TRACE(point, frame_id, type, size) \
+    ::uart_protocol::trace::record(::uart_protocol::trace::TracePoint::point, (frame_id), (type), (size))
+#define UART_PROTOCOL_TRACE_FRAME_ID() ::uart_protocol::trace::next_frame_id()
+
+#else
+
+#define UART_PROTOCOL_TRACE(point, frame_id, type, size) ((void)0)
+#define UART_PROTOCOL_TRACE_FRAME_ID() 0u
+
+#endif
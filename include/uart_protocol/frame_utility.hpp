@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <vector>
 #include <cstddef>
+#include <cstring>
 
 /*
  * Frame Utility - Helper functions for frame construction (for UART protocol design) and parsing.
@@ -36,21 +37,73 @@ namespace uart_protocol
     */
     inline uint16_t crc16_ccitt(const uint8_t *data, size_t len)
     {
-        uint16_t crc = 0xFFFF;
-        for (size_t i = 0; i < len; ++i)
+        // One table lookup per byte instead of 8 shift/xor steps (same result as the bitwise form)
+        struct Table
         {
-            crc ^= static_cast<uint16_t>(data[i]) << 8;
-            for (int j = 0; j < 8; ++j)
+            uint16_t entries[256];
+            constexpr Table() : entries()
             {
-                if (crc & 0x8000)
-                    crc = (crc << 1) ^ 0x1021;
-                else
-                    crc <<= 1;
+                for (int byte = 0; byte < 256; ++byte)
+                {
+                    uint16_t crc = static_cast<uint16_t>(byte << 8);
+                    for (int j = 0; j < 8; ++j)
+                    {
+                        if (crc & 0x8000)
+                            crc = static_cast<uint16_t>((crc << 1) ^ 0x1021);
+                        else
+                            crc = static_cast<uint16_t>(crc << 1);
+                    }
+                    entries[byte] = crc;
+                }
             }
+        };
+        static constexpr Table table{};
+
+        uint16_t crc = 0xFFFF;
+        for (size_t i = 0; i < len; ++i)
+        {
+            crc = static_cast<uint16_t>((crc << 8) ^ table.entries[((crc >> 8) ^ data[i]) & 0xFF]);
         }
         return crc;
     }
 
+    // Frame overhead: [START_WORD (2 bytes)] + [LEN (1 byte)] + [TYPE (1 byte)] + [CRC16 (2 bytes)]
+    inline constexpr size_t FRAME_OVERHEAD = 6;
+    // Largest encoded frame (LEN is 1 byte, so the payload is at most 255 bytes)
+    inline constexpr size_t MAX_FRAME_SIZE = FRAME_OVERHEAD + 255;
+
+    // Encode a frame straight into a caller-provided buffer (no allocation).
+    // `out` must hold at least FRAME_OVERHEAD + payload_len bytes. Returns the encoded size, 0 if payload_len > 255.
+    inline size_t encode_frame(uint8_t type, const uint8_t *payload, size_t payload_len, uint8_t *out)
+    {
+        if (payload_len > MAX_FRAME_SIZE - FRAME_OVERHEAD)
+        {
+            return 0;
+        }
+
+        // START_WORD (little-endian)
+        out[0] = static_cast<uint8_t>(Frame::START_WORD & 0xFF);
+        out[1] = static_cast<uint8_t>((Frame::START_WORD >> 8) & 0xFF);
+
+        // LEN, TYPE
+        out[2] = static_cast<uint8_t>(payload_len);
+        out[3] = type;
+
+        // PAYLOAD
+        for (size_t i = 0; i < payload_len; ++i)
+        {
+            out[4 + i] = payload[i];
+        }
+
+        // CRC16 over everything except the CRC itself
+        size_t crc_offset = 4 + payload_len;
+        uint16_t crc = crc16_ccitt(out, crc_offset);
+        out[crc_offset] = static_cast<uint8_t>(crc & 0xFF);
+        out[crc_offset + 1] = static_cast<uint8_t>((crc >> 8) & 0xFF);
+
+        return crc_offset + 2;
+    }
+
     // Construct a raw byte vector from a Frame structure. Returns the raw byte vector.
     inline std::vector<uint8_t> construct_frame(const Frame &frame)
     {
@@ -129,4 +182,118 @@ namespace uart_protocol
         consumed_bytes = frame_size; // Indicate how many bytes were consumed
         return true;
     }
-}
\ No newline at end of file
+
+    // Non-owning view of a frame inside a byte buffer (valid as long as the buffer is unchanged)
+    struct FrameView
+    {
+        uint8_t type = 0;
+        const uint8_t *payload = nullptr;
+        size_t payload_size = 0;
+    };
+
+    enum class ParseStatus : uint8_t
+    {
+        Ok,           // A valid frame starts at offset 0
+        NeedMoreData, // Could still be a valid frame, wait for more bytes
+        Invalid       // No valid frame at offset 0 (bad START_WORD or CRC), skip to resync
+    };
+
+    // Offset of the first possible START_WORD at or after `from`. A trailing first byte counts as a
+    // candidate (its second byte may not have arrived yet). Returns len if there is none.
+    inline size_t find_start_word(const uint8_t *data, size_t len, size_t from = 0)
+    {
+        const uint8_t first = static_cast<uint8_t>(Frame::START_WORD & 0xFF);
+        const uint8_t second = static_cast<uint8_t>((Frame::START_WORD >> 8) & 0xFF);
+        while (from < len)
+        {
+            const void *hit = std::memchr(data + from, first, len - from);
+            if (hit == nullptr)
+            {
+                return len;
+            }
+            size_t pos = static_cast<size_t>(static_cast<const uint8_t *>(hit) - data);
+            if (pos + 1 == len || data[pos + 1] == second)
+            {
+                return pos;
+            }
+            from = pos + 1;
+        }
+        return len;
+    }
+
+    /*
+     * Decode the frame at the start of a raw buffer without copying the payload.
+     * @param data Buffer that should start with a frame.
+     * @param len Bytes available in the buffer.
+     * @param out_frame View into `data` on ParseStatus::Ok.
+     * @param consumed_bytes Ok: frame size. Invalid: bytes to drop before the next START_WORD candidate. Otherwise 0.
+     */
+    inline ParseStatus decode_frame(const uint8_t *data, size_t len, FrameView &out_frame, size_t &consumed_bytes)
+    {
+        consumed_bytes = 0;
+
+        // Check START_WORD as soon as its bytes are there, so garbage is skipped early
+        uint16_t start_word = len >= 2 ? static_cast<uint16_t>(data[0]) | (static_cast<uint16_t>(data[1]) << 8) : 0;
+        if ((len >= 2 && start_word != Frame::START_WORD) ||
+            (len == 1 && data[0] != static_cast<uint8_t>(Frame::START_WORD & 0xFF)))
+        {
+            consumed_bytes = find_start_word(data, len, 1);
+            return ParseStatus::Invalid;
+        }
+
+        if (len < FRAME_OVERHEAD)
+        {
+            return ParseStatus::NeedMoreData;
+        }
+
+        size_t frame_size = FRAME_OVERHEAD + data[2];
+        if (len < frame_size)
+        {
+            return ParseStatus::NeedMoreData;
+        }
+
+        uint16_t received_crc = static_cast<uint16_t>(data[frame_size - 2]) | (static_cast<uint16_t>(data[frame_size - 1]) << 8);
+        if (received_crc != crc16_ccitt(data, frame_size - 2))
+        {
+            consumed_bytes = find_start_word(data, len, 1);
+            return ParseStatus::Invalid;
+        }
+
+        out_frame.type = data[3];
+        out_frame.payload = data + 4;
+        out_frame.payload_size = data[2];
+        consumed_bytes = frame_size;
+        return ParseStatus::Ok;
+    }
+
+    /*
+     * Decode every complete frame in a raw buffer in one pass, skipping garbage and CRC errors.
+     * @param data Buffer to decode.
+     * @param len Bytes available in the buffer.
+     * @param out Receives a view into `data` for each frame, in stream order.
+     * @param max_frames Capacity of `out`; decoding stops when it is full.
+     * @param consumed_bytes Offset of the first byte not consumed (start of an incomplete frame or of the next frame).
+     * @return Number of frames written to `out`.
+     */
+    inline size_t decode_frames(const uint8_t *data, size_t len, FrameView *out, size_t max_frames, size_t &consumed_bytes)
+    {
+        size_t count = 0;
+        size_t offset = 0;
+        while (count < max_frames && offset < len)
+        {
+            size_t consumed = 0;
+            ParseStatus status = decode_frame(data + offset, len - offset, out[count], consumed);
+            if (status == ParseStatus::NeedMoreData)
+            {
+                break;
+            }
+            if (status == ParseStatus::Ok)
+            {
+                ++count;
+            }
+            offset += consumed;
+        }
+        consumed_bytes = offset;
+        return count;
+    }
+} // namespace uart_protocol
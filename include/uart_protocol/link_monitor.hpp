@@ -0,0 +1,261 @@
+#pragma once
+#include "ProtocolConfig.hpp"
+#include "timer_wheel.hpp"
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * Link Monitor - Liveness tracking with ARE_YOU_THERE keep-alives.
+ *
+ * Every received frame is proof of life. A link that carries traffic therefore never sends a
+ * keep-alive; only after config::LINK_IDLE_MS of silence is an ARE_YOU_THERE frame sent, and any frame
+ * coming back (typically the peer's ACK) counts as the answer.
+ *
+ * State with hysteresis:
+ *   Up       -> Degraded  after LINK_DEGRADED_AFTER unanswered probes
+ *   Up/Degr. -> Down      after LINK_DOWN_AFTER unanswered probes
+ *   Down     -> Degraded  on the first received frame
+ *   Degr./Down -> Up      after LINK_UP_AFTER frames without an unanswered probe in between
+ *                         (a single stray answer does not flap the link)
+ * A down link is probed every LINK_DOWN_PROBE_INTERVAL_MS only, to keep slow links free.
+ *
+ * Scaling: each link is a LinkLiveness object with one embedded TimerNode on a shared TimerWheel
+ * ticking in milliseconds, so hundreds of links cost no threads and no scanning. on_frame() only
+ * stores a timestamp (the wheel's current tick); the idle timer is re-armed lazily when it fires.
+ *
+ * Bandwidth: a probe is one 6-byte frame per LINK_IDLE_MS on an idle link (about 0.6% of 9600 baud
+ * at the defaults), nothing on a busy link.
+ *
+ * Note: Not internally synchronized. Callbacks run inside wheel.advance() / on_frame().
+ *
+ * Usage:
+ *   uart_protocol::TimerWheel wheel(timing::get_tick_ms());
+ *   uart_protocol::LinkMonitor monitor(wheel);
+ *   monitor.add(link_a, send_probe, on_state_change, &device_a); // send_probe sends ARE_YOU_THERE on that link
+ *   monitor.on_frame(link_a, frame.type);                       // for every frame received on that link
+ *   wheel.advance(timing::get_tick_ms());                       // from the main loop
+ */
+
+namespace uart_protocol
+{
+    enum class LinkState : uint8_t
+    {
+        Down,
+        Degraded,
+        Up
+    };
+
+    // Send one frame of `type` on the link (ARE_YOU_THERE probe, or ACK answering a peer's probe)
+    using LinkSendFn = bool (*)(void *context, uint8_t type);
+    // Called on every state change
+    using LinkStateCallback = void (*)(void *context, LinkState previous, LinkState current);
+
+    struct LinkMonitorConfig
+    {
+        uint32_t idle_ms = config::LINK_IDLE_MS;
+        uint32_t probe_timeout_ms = config::LINK_PROBE_TIMEOUT_MS;
+        uint32_t down_probe_interval_ms = config::LINK_DOWN_PROBE_INTERVAL_MS;
+        uint8_t degraded_after = config::LINK_DEGRADED_AFTER;
+        uint8_t down_after = config::LINK_DOWN_AFTER;
+        uint8_t up_after = config::LINK_UP_AFTER; // Consecutive frames needed to return to Up
+        bool answer_probes = true; // Reply to the peer's ARE_YOU_THERE with an ACK
+    };
+
+    class LinkMonitor;
+
+    // Per-link liveness state, owned by the application (must not move while added to a monitor)
+    class LinkLiveness
+    {
+    private:
+        friend class LinkMonitor;
+
+        TimerNode timer_;
+        LinkMonitor *monitor_ = nullptr;
+        LinkSendFn send_ = nullptr;
+        LinkStateCallback on_change_ = nullptr;
+        void *context_ = nullptr;
+
+        LinkState state_ = LinkState::Down;
+        uint32_t last_rx_ = 0;    // Wheel tick of the last received frame
+        bool rx_seen_ = false;    // A frame arrived since the last probe was sent
+        bool probing_ = false;    // A probe is outstanding
+        uint8_t missed_ = 0;      // Consecutive unanswered probes
+        uint8_t received_ = 0;    // Frames received since the last unanswered probe (for LINK_UP_AFTER)
+        uint32_t probes_sent_ = 0;
+
+    public:
+        LinkLiveness() = default;
+        LinkLiveness(const LinkLiveness &) = delete;
+        LinkLiveness &operator=(const LinkLiveness &) = delete;
+
+        LinkState state() const { return state_; }
+        bool up() const { return state_ == LinkState::Up; }
+        uint8_t missed_probes() const { return missed_; }
+        uint32_t probes_sent() const { return probes_sent_; }
+        bool monitored() const { return monitor_ != nullptr; }
+    };
+
+    class LinkMonitor
+    {
+    private:
+        TimerWheel &wheel_;
+        LinkMonitorConfig config_;
+        size_t links_ = 0;
+
+        static void set_state(LinkLiveness &link, LinkState state)
+        {
+            if (link.state_ == state)
+            {
+                return;
+            }
+            LinkState previous = link.state_;
+            link.state_ = state;
+            if (link.on_change_ != nullptr)
+            {
+                link.on_change_(link.context_, previous, state);
+            }
+        }
+
+        void send_probe(LinkLiveness &link)
+        {
+            link.probing_ = true;
+            link.rx_seen_ = false;
+            ++link.probes_sent_;
+            link.send_(link.context_, config::ARE_YOU_THERE_TYPE);
+            uint32_t wait = link.state_ == LinkState::Down ? config_.down_probe_interval_ms : config_.probe_timeout_ms;
+            wheel_.schedule(link.timer_, wait, &LinkMonitor::on_timer, &link);
+        }
+
+        static void on_timer(TimerNode &, void *context)
+        {
+            auto &link = *static_cast<LinkLiveness *>(context);
+            link.monitor_->check(link);
+        }
+
+        void check(LinkLiveness &link)
+        {
+            uint32_t now = wheel_.now();
+            if (link.probing_ && !link.rx_seen_)
+            {
+                // Probe went unanswered
+                if (link.missed_ < 255)
+                {
+                    ++link.missed_;
+                }
+                link.received_ = 0;
+                if (link.missed_ >= config_.down_after)
+                {
+                    set_state(link, LinkState::Down);
+                }
+                else if (link.missed_ >= config_.degraded_after && link.state_ == LinkState::Up)
+                {
+                    set_state(link, LinkState::Degraded);
+                }
+                send_probe(link);
+                return;
+            }
+
+            // Traffic seen on an up link: sleep until it has been idle for idle_ms.
+            // A link that is coming back is confirmed with a probe right away instead.
+            uint32_t idle = now - link.last_rx_;
+            if (link.rx_seen_ && idle < config_.idle_ms && link.state_ == LinkState::Up)
+            {
+                link.probing_ = false;
+                wheel_.schedule(link.timer_, config_.idle_ms - idle, &LinkMonitor::on_timer, &link);
+                return;
+            }
+            send_probe(link);
+        }
+
+    public:
+        explicit LinkMonitor(TimerWheel &wheel, const LinkMonitorConfig &config = LinkMonitorConfig{}) : wheel_(wheel), config_(config) {}
+
+        LinkMonitor(const LinkMonitor &) = delete;
+        LinkMonitor &operator=(const LinkMonitor &) = delete;
+
+        /*
+         * Start monitoring a link. It starts Down and is probed right away.
+         * @param link Liveness state owned by the caller.
+         * @param send Sends a frame of the given type on this link (required).
+         * @param on_change State change callback (may be nullptr).
+         * @param context User pointer passed to both callbacks.
+         * @return false if the link is already monitored or send is nullptr.
+         */
+        bool add(LinkLiveness &link, LinkSendFn send, LinkStateCallback on_change, void *context)
+        {
+            if (link.monitor_ != nullptr || send == nullptr)
+            {
+                return false;
+            }
+            link.monitor_ = this;
+            link.send_ = send;
+            link.on_change_ = on_change;
+            link.context_ = context;
+            link.state_ = LinkState::Down;
+            link.last_rx_ = wheel_.now();
+            link.rx_seen_ = false;
+            link.probing_ = false;
+            link.missed_ = 0;
+            link.received_ = 0;
+            wheel_.schedule(link.timer_, 1, &LinkMonitor::on_timer, &link);
+            ++links_;
+            return true;
+        }
+
+        // Stop monitoring a link (no callback)
+        void remove(LinkLiveness &link)
+        {
+            if (link.monitor_ != this)
+            {
+                return;
+            }
+            wheel_.cancel(link.timer_);
+            link.monitor_ = nullptr;
+            --links_;
+        }
+
+        /*
+         * Report a frame received on the link. O(1), no timer operation except on the first frame of a down link.
+         * @param type Frame type; a peer's ARE_YOU_THERE is answered with an ACK when answer_probes is set.
+         */
+        void on_frame(LinkLiveness &link, uint8_t type)
+        {
+            if (link.monitor_ != this)
+            {
+                return;
+            }
+            link.last_rx_ = wheel_.now();
+            link.rx_seen_ = true;
+            link.missed_ = 0;
+
+            if (link.state_ != LinkState::Up)
+            {
+                if (link.received_ < 255)
+                {
+                    ++link.received_;
+                }
+                if (link.received_ >= config_.up_after)
+                {
+                    set_state(link, LinkState::Up);
+                }
+                else if (link.received_ == 1)
+                {
+                    if (link.state_ == LinkState::Down)
+                    {
+                        set_state(link, LinkState::Degraded);
+                    }
+                    // First sign of life: confirm soon instead of waiting for the next idle or down-state probe
+                    wheel_.schedule(link.timer_, config_.probe_timeout_ms, &LinkMonitor::on_timer, &link);
+                }
+            }
+
+            if (type == config::ARE_YOU_THERE_TYPE && config_.answer_probes)
+            {
+                link.send_(link.context_, config::ACK_TYPE);
+            }
+        }
+
+        size_t links() const { return links_; }
+        const LinkMonitorConfig &settings() const { return config_; }
+    };
+} // namespace uart_protocol
@@ -0,0 +1,333 @@
+#pragma once
+#include "peripheral.hpp"
+#include "ProtocolConfig.hpp"
+#include "frame_utility.hpp"
+#include "protocol.hpp"
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
+/*
+ * Message Schema - Compile-time typed payload serialization.
+ *
+ * A message struct is described once by specializing MessageSchema with its frame TYPE and the list
+ * of fields (member pointers) in wire order. From that description:
+ *  - message_wire_size<T> is the payload size, known at compile time
+ *  - encode_message()/send_message() serialize straight into the outgoing frame buffer (no vector)
+ *  - decode_message() fills the struct from a received FrameView/Frame after checking TYPE and size
+ *
+ * Supported field types: integers, bool, enums, float/double (IEEE 754), std::array and C arrays of
+ * supported types, and nested structs that have a MessageSchema themselves. No padding is sent.
+ * Multi-byte values are little-endian on the wire (like START_WORD and CRC16) unless the schema sets
+ * `static constexpr WireOrder byte_order = WireOrder::Big;`. Byte order conversion uses shifts, so
+ * the host's own endianness does not matter.
+ *
+ * Usage:
+ *   struct Telemetry { uint16_t id; int32_t temperature; float voltage; std::array<uint8_t, 4> raw; };
+ *
+ *   template <>
+ *   struct uart_protocol::MessageSchema<Telemetry>
+ *   {
+ *       static constexpr uint8_t frame_type = uart_protocol::config::DATA_TYPE;
+ *       static constexpr auto fields = uart_protocol::schema_fields(&Telemetry::id, &Telemetry::temperature,
+ *                                                                   &Telemetry::voltage, &Telemetry::raw);
+ *   };
+ *
+ *   static_assert(uart_protocol::message_wire_size<Telemetry> == 14);
+ *   uart_protocol::send_message(protocol, telemetry);
+ *   uart_protocol::decode_message(frame, telemetry); // false if TYPE or size do not match
+ */
+
+namespace uart_protocol
+{
+    enum class WireOrder : uint8_t
+    {
+        Little,
+        Big
+    };
+
+    // Specialize for each message struct: `frame_type` and `fields` (see schema_fields()). Optional: `byte_order`.
+    template <typename T>
+    struct MessageSchema;
+
+    // Field list of a schema, in wire order
+    template <typename T, typename... Members>
+    constexpr std::tuple<Members T::*...> schema_fields(Members T::*...members)
+    {
+        return std::tuple<Members T::*...>(members...);
+    }
+
+    template <typename T, typename = void>
+    struct has_message_schema : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct has_message_schema<T, std::void_t<decltype(MessageSchema<T>::fields), decltype(MessageSchema<T>::frame_type)>> : std::true_type
+    {
+    };
+
+    template <typename T, typename = void>
+    struct schema_byte_order : std::integral_constant<WireOrder, WireOrder::Little>
+    {
+    };
+
+    template <typename T>
+    struct schema_byte_order<T, std::void_t<decltype(MessageSchema<T>::byte_order)>>
+        : std::integral_constant<WireOrder, MessageSchema<T>::byte_order>
+    {
+    };
+
+    // Wire encoding of one field type. Specialize to add custom field types.
+    template <typename F, typename = void>
+    struct WireCodec
+    {
+        static_assert(sizeof(F) == 0, "Unsupported field type: use integers, bool, enums, float/double, arrays or schema structs");
+    };
+
+    // Unsigned type carrying the bits of an integer, bool or enum field
+    template <typename F, bool = std::is_enum_v<F>>
+    struct wire_bits
+    {
+        using type = std::make_unsigned_t<F>;
+    };
+
+    template <typename F>
+    struct wire_bits<F, true>
+    {
+        using type = std::make_unsigned_t<std::underlying_type_t<F>>;
+    };
+
+    template <>
+    struct wire_bits<bool, false>
+    {
+        using type = uint8_t;
+    };
+
+    // Integers and enums: sizeof(F) bytes
+    template <typename F>
+    struct WireCodec<F, std::enable_if_t<std::is_integral_v<F> || std::is_enum_v<F>>>
+    {
+        using Bits = typename wire_bits<F>::type;
+        static constexpr size_t size = sizeof(Bits);
+
+        static void write(const F &value, uint8_t *out, WireOrder order)
+        {
+            uint64_t bits = static_cast<Bits>(value);
+            for (size_t i = 0; i < size; ++i)
+            {
+                size_t index = order == WireOrder::Little ? i : size - 1 - i;
+                out[index] = static_cast<uint8_t>(bits & 0xFF);
+                bits >>= 8;
+            }
+        }
+
+        static void read(const uint8_t *in, F &value, WireOrder order)
+        {
+            uint64_t bits = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                size_t index = order == WireOrder::Little ? size - 1 - i : i;
+                bits = (bits << 8) | in[index];
+            }
+            if constexpr (std::is_same_v<F, bool>)
+            {
+                value = bits != 0;
+            }
+            else
+            {
+                value = static_cast<F>(static_cast<Bits>(bits));
+            }
+        }
+    };
+
+    // float/double: IEEE 754 bit pattern, same byte order as integers
+    template <typename F>
+    struct WireCodec<F, std::enable_if_t<std::is_floating_point_v<F>>>
+    {
+        static_assert(std::numeric_limits<F>::is_iec559 && (sizeof(F) == 4 || sizeof(F) == 8), "Floating point fields must be IEEE 754 binary32/binary64");
+        using Bits = std::conditional_t<sizeof(F) == 4, uint32_t, uint64_t>;
+        static constexpr size_t size = sizeof(F);
+
+        static void write(const F &value, uint8_t *out, WireOrder order)
+        {
+            Bits bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            WireCodec<Bits>::write(bits, out, order);
+        }
+
+        static void read(const uint8_t *in, F &value, WireOrder order)
+        {
+            Bits bits;
+            WireCodec<Bits>::read(in, bits, order);
+            std::memcpy(&value, &bits, sizeof(bits));
+        }
+    };
+
+    // Fixed-size arrays: elements back to back
+    template <typename E, size_t N>
+    struct WireCodec<std::array<E, N>>
+    {
+        static constexpr size_t size = N * WireCodec<E>::size;
+
+        static void write(const std::array<E, N> &value, uint8_t *out, WireOrder order)
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                WireCodec<E>::write(value[i], out + i * WireCodec<E>::size, order);
+            }
+        }
+
+        static void read(const uint8_t *in, std::array<E, N> &value, WireOrder order)
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                WireCodec<E>::read(in + i * WireCodec<E>::size, value[i], order);
+            }
+        }
+    };
+
+    template <typename E, size_t N>
+    struct WireCodec<E[N]>
+    {
+        static constexpr size_t size = N * WireCodec<E>::size;
+
+        static void write(const E (&value)[N], uint8_t *out, WireOrder order)
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                WireCodec<E>::write(value[i], out + i * WireCodec<E>::size, order);
+            }
+        }
+
+        static void read(const uint8_t *in, E (&value)[N], WireOrder order)
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                WireCodec<E>::read(in + i * WireCodec<E>::size, value[i], order);
+            }
+        }
+    };
+
+    // Nested structs with their own schema (their byte_order is ignored, the outer message decides)
+    template <typename F>
+    struct WireCodec<F, std::enable_if_t<std::is_class_v<F> && has_message_schema<F>::value>>
+    {
+    private:
+        template <size_t... I>
+        static constexpr size_t sum_sizes(std::index_sequence<I...>)
+        {
+            using Fields = std::remove_const_t<decltype(MessageSchema<F>::fields)>;
+            return (size_t{0} + ... + WireCodec<std::remove_cv_t<std::remove_reference_t<
+                                          decltype(std::declval<F &>().*std::get<I>(std::declval<Fields>()))>>>::size);
+        }
+
+        static constexpr size_t FIELD_COUNT = std::tuple_size_v<std::remove_const_t<decltype(MessageSchema<F>::fields)>>;
+
+    public:
+        static constexpr size_t size = sum_sizes(std::make_index_sequence<FIELD_COUNT>{});
+
+        static void write(const F &value, uint8_t *out, WireOrder order)
+        {
+            std::apply([&](auto... members)
+                       { ((WireCodec<std::remove_cv_t<std::remove_reference_t<decltype(value.*members)>>>::write(value.*members, out, order),
+                           out += WireCodec<std::remove_cv_t<std::remove_reference_t<decltype(value.*members)>>>::size),
+                          ...); },
+                       MessageSchema<F>::fields);
+        }
+
+        static void read(const uint8_t *in, F &value, WireOrder order)
+        {
+            std::apply([&](auto... members)
+                       { ((WireCodec<std::remove_cv_t<std::remove_reference_t<decltype(value.*members)>>>::read(in, value.*members, order),
+                           in += WireCodec<std::remove_cv_t<std::remove_reference_t<decltype(value.*members)>>>::size),
+                          ...); },
+                       MessageSchema<F>::fields);
+        }
+    };
+
+    // Payload size of a message, known at compile time
+    template <typename T>
+    inline constexpr size_t message_wire_size = WireCodec<T>::size;
+
+    // Frame size of a message (payload + FRAME_OVERHEAD)
+    template <typename T>
+    inline constexpr size_t message_frame_size = FRAME_OVERHEAD + message_wire_size<T>;
+
+    /*
+     * Serialize a message payload into a caller-provided buffer.
+     * @param out At least message_wire_size<T> bytes.
+     * @return message_wire_size<T>.
+     */
+    template <typename T>
+    inline size_t serialize_message(const T &message, uint8_t *out)
+    {
+        static_assert(has_message_schema<T>::value, "T needs a MessageSchema specialization");
+        WireCodec<T>::write(message, out, schema_byte_order<T>::value);
+        return message_wire_size<T>;
+    }
+
+    /*
+     * Deserialize a message from a payload.
+     * @return false if len differs from message_wire_size<T> (message is left unchanged).
+     */
+    template <typename T>
+    inline bool deserialize_message(const uint8_t *payload, size_t len, T &message)
+    {
+        static_assert(has_message_schema<T>::value, "T needs a MessageSchema specialization");
+        if (len != message_wire_size<T>)
+        {
+            return false;
+        }
+        WireCodec<T>::read(payload, message, schema_byte_order<T>::value);
+        return true;
+    }
+
+    /*
+     * Encode a complete frame for a message, serializing the fields in place after the frame header.
+     * @param out At least message_frame_size<T> bytes.
+     * @return message_frame_size<T>.
+     */
+    template <typename T>
+    inline size_t encode_message(const T &message, uint8_t *out)
+    {
+        static_assert(message_wire_size<T> <= config::MAX_PAYLOAD_SIZE, "Message does not fit into one frame");
+
+        out[0] = static_cast<uint8_t>(Frame::START_WORD & 0xFF);
+        out[1] = static_cast<uint8_t>((Frame::START_WORD >> 8) & 0xFF);
+        out[2] = static_cast<uint8_t>(message_wire_size<T>);
+        out[3] = MessageSchema<T>::frame_type;
+        serialize_message(message, out + 4);
+
+        size_t crc_offset = 4 + message_wire_size<T>;
+        uint16_t crc = crc16_ccitt(out, crc_offset);
+        out[crc_offset] = static_cast<uint8_t>(crc & 0xFF);
+        out[crc_offset + 1] = static_cast<uint8_t>((crc >> 8) & 0xFF);
+        return message_frame_size<T>;
+    }
+
+    // Encode a message in place into a stack frame buffer and send it with protocol.send_encoded() (no second copy)
+    template <typename UartT, typename T>
+    inline bool send_message(BasicProtocol<UartT> &protocol, const T &message)
+    {
+        uint8_t frame[message_frame_size<T>];
+        return protocol.send_encoded(frame, encode_message(message, frame));
+    }
+
+    // Decode a received frame into a message. Returns false if TYPE or payload size do not match the schema.
+    template <typename T>
+    inline bool decode_message(const FrameView &frame, T &message)
+    {
+        return frame.type == MessageSchema<T>::frame_type && deserialize_message(frame.payload, frame.payload_size, message);
+    }
+
+    template <typename T>
+    inline bool decode_message(const Frame &frame, T &message)
+    {
+        return frame.type == MessageSchema<T>::frame_type && deserialize_message(frame.payload.data(), frame.payload.size(), message);
+    }
+} // namespace uart_protocol
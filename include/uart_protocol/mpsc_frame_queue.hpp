@@ -0,0 +1,258 @@
+#pragma once
+#include "peripheral.hpp"
+#include "ProtocolConfig.hpp"
+#include "frame_utility.hpp"
+#include "frame_trace.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/*
+ * MPSC Frame Queue - Lock-free multi-producer/single-consumer queue of encoded frames.
+ *
+ * Many threads enqueue frames concurrently without a lock, a single drainer writes them to the Uart.
+ * Each frame is handed to the driver in exactly one send_data() call, so frames from different
+ * producers never interleave on the wire.
+ *
+ * Bounded array queue with a sequence number per cell (D. Vyukov's design):
+ *  - producers claim a cell with one CAS on the enqueue position, then encode into it in place
+ *  - the consumer owns the dequeue position and needs no atomic read-modify-write at all (it is only
+ *    stored atomically so pending() can read it from producer threads)
+ *  - a full queue is reported immediately (TxStatus::QueueFull), nothing blocks
+ *
+ * ConcurrentSendUart wraps a driver with this queue so an unchanged BasicProtocol can be shared by
+ * several sending threads: send_frame() encodes on the caller's stack and its single send_data()
+ * call becomes one queued frame. Only the send path is made thread-safe, receive is forwarded as is.
+ *
+ * Usage:
+ *   uart_protocol::ConcurrentSendUart<MyUart> tx(my_uart);
+ *   uart_protocol::BasicProtocol<decltype(tx)> protocol(tx);
+ *   protocol.send_frame(type, payload);   // any thread
+ *   tx.drain();                           // one drainer thread
+ */
+
+namespace uart_protocol
+{
+    enum class TxStatus : uint8_t
+    {
+        Queued,         // Frame encoded and queued
+        QueueFull,      // Queue is at its depth limit (backpressure)
+        PayloadTooLarge // Payload exceeds config::MAX_PAYLOAD_SIZE
+    };
+
+    template <size_t Depth = config::TX_CONCURRENT_QUEUE_DEPTH>
+    class MpscFrameQueue
+    {
+        static_assert(Depth >= 2 && (Depth & (Depth - 1)) == 0, "Depth must be a power of two (>= 2)");
+
+    private:
+        static constexpr size_t MASK = Depth - 1;
+
+        struct alignas(64) Cell
+        {
+            std::atomic<size_t> sequence{0};
+            uint16_t size = 0;
+#if configUSE_TRACING
+            uint32_t trace_id = 0;
+#endif
+            uint8_t bytes[MAX_FRAME_SIZE];
+        };
+
+        Cell cells_[Depth];
+        alignas(64) std::atomic<size_t> enqueue_pos_{0};
+        alignas(64) std::atomic<size_t> dequeue_pos_{0}; // Written by the consumer only, read by pending()
+        std::atomic<uint64_t> rejected_{0};
+
+        // Claim a cell for writing, nullptr if the queue is full
+        Cell *claim(size_t &pos)
+        {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = cells_[pos & MASK];
+                size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        return &cell;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    rejected_.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr; // Consumer has not freed this cell yet
+                }
+                else
+                {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed); // Another producer took it
+                }
+            }
+        }
+
+        static void publish(Cell &cell, size_t pos)
+        {
+            cell.sequence.store(pos + 1, std::memory_order_release);
+        }
+
+    public:
+        MpscFrameQueue()
+        {
+            for (size_t i = 0; i < Depth; ++i)
+            {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscFrameQueue(const MpscFrameQueue &) = delete;
+        MpscFrameQueue &operator=(const MpscFrameQueue &) = delete;
+
+        // Producer (any thread): encode a frame straight into a queue cell
+        TxStatus push_frame(uint8_t type, const uint8_t *payload, size_t payload_len)
+        {
+            if (payload_len > config::MAX_PAYLOAD_SIZE)
+            {
+                return TxStatus::PayloadTooLarge;
+            }
+            size_t pos;
+            Cell *cell = claim(pos);
+            if (cell == nullptr)
+            {
+                return TxStatus::QueueFull;
+            }
+#if configUSE_TRACING
+            cell->trace_id = UART_PROTOCOL_TRACE_FRAME_ID();
+#endif
+            UART_PROTOCOL_TRACE(Enqueued, cell->trace_id, type, payload_len);
+            cell->size = static_cast<uint16_t>(encode_frame(type, payload, payload_len, cell->bytes));
+            UART_PROTOCOL_TRACE(Encoded, cell->trace_id, type, cell->size);
+            publish(*cell, pos);
+            return TxStatus::Queued;
+        }
+
+        // Producer (any thread): queue already encoded bytes as one unit (at most MAX_FRAME_SIZE)
+        TxStatus push_raw(const uint8_t *data, size_t size)
+        {
+            if (size > MAX_FRAME_SIZE)
+            {
+                return TxStatus::PayloadTooLarge;
+            }
+            size_t pos;
+            Cell *cell = claim(pos);
+            if (cell == nullptr)
+            {
+                return TxStatus::QueueFull;
+            }
+            std::memcpy(cell->bytes, data, size);
+            cell->size = static_cast<uint16_t>(size);
+#if configUSE_TRACING
+            cell->trace_id = UART_PROTOCOL_TRACE_FRAME_ID();
+#endif
+            UART_PROTOCOL_TRACE(Enqueued, cell->trace_id, size > 3 ? data[3] : 0, size);
+            publish(*cell, pos);
+            return TxStatus::Queued;
+        }
+
+        /*
+         * Consumer (single thread): write queued frames to the Uart in queue order.
+         * @return Number of frames written. Stops when the queue is empty, the next frame is still being
+         *         written by its producer, or the driver refuses a frame (it stays queued).
+         */
+        template <typename UartT>
+        size_t drain(UartT &uart, size_t max_frames = SIZE_MAX)
+        {
+            size_t sent = 0;
+            size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            while (sent < max_frames)
+            {
+                Cell &cell = cells_[pos & MASK];
+                if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+                {
+                    break;
+                }
+                UART_PROTOCOL_TRACE(SendData, cell.trace_id, cell.bytes[3], cell.size);
+                if (!uart_send_data(uart, cell.bytes, cell.size))
+                {
+                    break;
+                }
+                cell.sequence.store(pos + Depth, std::memory_order_release);
+                ++pos;
+                dequeue_pos_.store(pos, std::memory_order_release);
+                ++sent;
+            }
+            return sent;
+        }
+
+        // Consumer: a fully written frame is at the front (the next drain() writes it unless the driver refuses)
+        bool ready() const
+        {
+            size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            return cells_[pos & MASK].sequence.load(std::memory_order_acquire) == pos + 1;
+        }
+
+        // Consumer: drop every fully written frame without sending it. Returns the number dropped.
+        size_t discard()
+        {
+            size_t dropped = 0;
+            size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            while (cells_[pos & MASK].sequence.load(std::memory_order_acquire) == pos + 1)
+            {
+                cells_[pos & MASK].sequence.store(pos + Depth, std::memory_order_release);
+                ++pos;
+                dequeue_pos_.store(pos, std::memory_order_release);
+                ++dropped;
+            }
+            return dropped;
+        }
+
+        // Frames claimed by producers and not yet drained (snapshot, callable from any thread)
+        size_t pending() const
+        {
+            // Dequeue first: it never passes the enqueue position, so the difference cannot underflow
+            size_t dequeued = dequeue_pos_.load(std::memory_order_acquire);
+            size_t enqueued = enqueue_pos_.load(std::memory_order_acquire);
+            return enqueued - dequeued;
+        }
+
+        // push_*() calls rejected with QueueFull
+        uint64_t rejected() const { return rejected_.load(std::memory_order_relaxed); }
+    };
+
+    template <typename UartT, size_t Depth = config::TX_CONCURRENT_QUEUE_DEPTH>
+    class ConcurrentSendUart final : public Uart
+    {
+        static_assert(is_uart_transport<UartT>::value, "UartT must provide init(), deinit(), send_data() and receive_data()");
+
+    private:
+        UartT &uart_;
+        MpscFrameQueue<Depth> queue_;
+
+    public:
+        explicit ConcurrentSendUart(UartT &uart) : uart_(uart) {}
+
+        bool init() override { return uart_.init(); }
+        void deinit() override { uart_.deinit(); }
+
+        // Any thread: queue one frame. Returns false if the queue is full (backpressure) or size > MAX_FRAME_SIZE.
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            return queue_.push_raw(data, size) == TxStatus::Queued;
+        }
+
+        size_t receive_data(uint8_t *out_buffer, size_t max_bytes) override
+        {
+            return uart_receive_data(uart_, out_buffer, max_bytes);
+        }
+
+        // Drainer thread only: write queued frames, one driver call per frame
+        size_t drain(size_t max_frames = SIZE_MAX)
+        {
+            return queue_.drain(uart_, max_frames);
+        }
+
+        MpscFrameQueue<Depth> &queue() { return queue_; }
+        UartT &uart() { return uart_; }
+    };
+} // namespace uart_protocol
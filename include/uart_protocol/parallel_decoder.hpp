@@ -0,0 +1,285 @@
+#pragma once
+#include "frame_utility.hpp"
+#include "capture.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/*
+ * Parallel Decoder - Multi-threaded offline decoding of large byte streams into a frame index.
+ *
+ * The stream is split into one chunk per worker. Each worker starts decoding at its chunk start,
+ * resyncs on START_WORD and verifies CRCs on its own, and keeps the frames that START inside its
+ * chunk (a frame may run past the chunk end, the worker reads on into the next chunk).
+ *
+ * Reconciliation: a worker that starts in the middle of a frame may decode a different path than a
+ * sequential decoder (e.g. a frame embedded in another frame's payload). After all workers finish,
+ * the sequential path is re-run from where the previous chunk really ended until it lands on a frame
+ * start the worker also found. From there both paths are identical (decode_frame is deterministic),
+ * so the rest of the worker's frames are taken as-is. This usually costs a frame or two per chunk.
+ *
+ * The result is identical to decoding the whole buffer sequentially with decode_frame() (a frame cut
+ * off by the end of the stream is skipped like a corrupt one).
+ *
+ * Usage:
+ *   auto index = uart_protocol::FrameIndex::build(data, size);   // all hardware threads
+ *   uart_protocol::FrameView frame = index.frame(data, 123456);  // random access to frame N
+ *   index.save("link.upidx");                                     // reuse without decoding again
+ */
+
+namespace uart_protocol
+{
+    struct FrameIndexEntry
+    {
+        uint64_t offset = 0; // Offset of the START_WORD in the stream
+        uint16_t size = 0;   // Encoded frame size
+        uint8_t type = 0;    // Frame TYPE
+    };
+
+    class FrameIndex
+    {
+    private:
+        std::vector<FrameIndexEntry> entries_;
+        uint64_t skipped_bytes_ = 0; // Bytes not covered by any frame (noise, corrupt frames)
+
+        static constexpr size_t INDEX_HEADER_SIZE = 16; // COUNT + SKIPPED BYTES in the saved index
+        static constexpr size_t INDEX_RECORD_SIZE = 11; // OFFSET + SIZE + TYPE per entry
+
+        struct ChunkResult
+        {
+            std::vector<FrameIndexEntry> frames;
+            uint64_t end = 0; // Position after the last decode step (>= chunk end, or stream end)
+        };
+
+        // One decode step at `pos`. The stream is complete, so a frame cut off by its end is skipped like an invalid one.
+        static ParseStatus decode_at(const uint8_t *data, uint64_t size, uint64_t pos, FrameView &view, size_t &consumed)
+        {
+            ParseStatus status = decode_frame(data + pos, static_cast<size_t>(size - pos), view, consumed);
+            if (status == ParseStatus::NeedMoreData)
+            {
+                consumed = find_start_word(data + pos, static_cast<size_t>(size - pos), 1);
+                return ParseStatus::Invalid;
+            }
+            return status;
+        }
+
+        // Sequential decode of frames starting in [begin, end). Reads past `end` to complete a frame.
+        static void decode_range(const uint8_t *data, uint64_t size, uint64_t begin, uint64_t end, ChunkResult &out)
+        {
+            uint64_t pos = begin;
+            while (pos < end)
+            {
+                FrameView view;
+                size_t consumed = 0;
+                if (decode_at(data, size, pos, view, consumed) == ParseStatus::Ok)
+                {
+                    out.frames.push_back({pos, static_cast<uint16_t>(consumed), view.type});
+                }
+                pos += consumed;
+            }
+            out.end = pos;
+        }
+
+    public:
+        /*
+         * Decode a stream in parallel and build its frame index.
+         * @param data Stream bytes (e.g. a MappedFile or capture::collect_stream() output).
+         * @param size Stream size.
+         * @param threads Worker count, 0 = std::thread::hardware_concurrency().
+         */
+        static FrameIndex build(const uint8_t *data, uint64_t size, unsigned threads = 0)
+        {
+            if (threads == 0)
+            {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            // Chunks much smaller than a frame only add reconciliation work
+            uint64_t max_chunks = std::max<uint64_t>(1, size / (16 * MAX_FRAME_SIZE));
+            size_t chunks = static_cast<size_t>(std::min<uint64_t>(threads, max_chunks));
+
+            std::vector<uint64_t> bounds(chunks + 1);
+            for (size_t i = 0; i <= chunks; ++i)
+            {
+                bounds[i] = size * i / chunks;
+            }
+
+            std::vector<ChunkResult> results(chunks);
+            std::vector<std::thread> workers;
+            workers.reserve(chunks - 1);
+            for (size_t i = 1; i < chunks; ++i)
+            {
+                workers.emplace_back([&, i]
+                                     {
+                    results[i].frames.reserve(static_cast<size_t>((bounds[i + 1] - bounds[i]) / 32));
+                    decode_range(data, size, bounds[i], bounds[i + 1], results[i]); });
+            }
+            decode_range(data, size, bounds[0], bounds[1], results[0]);
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+
+            // Reconcile chunk boundaries in stream order
+            FrameIndex index;
+            size_t total = 0;
+            for (const auto &result : results)
+            {
+                total += result.frames.size();
+            }
+            index.entries_.reserve(total);
+            index.entries_.insert(index.entries_.end(), results[0].frames.begin(), results[0].frames.end());
+            uint64_t pos = results[0].end;
+
+            for (size_t i = 1; i < chunks; ++i)
+            {
+                const auto &frames = results[i].frames;
+                auto next = frames.begin();
+                bool converged = false;
+                while (pos < bounds[i + 1])
+                {
+                    // Frames the worker found before `pos` were skipped by the sequential path
+                    next = std::lower_bound(next, frames.end(), pos, [](const FrameIndexEntry &entry, uint64_t value)
+                                            { return entry.offset < value; });
+                    if (next != frames.end() && next->offset == pos)
+                    {
+                        converged = true;
+                        break;
+                    }
+
+                    FrameView view;
+                    size_t consumed = 0;
+                    if (decode_at(data, size, pos, view, consumed) == ParseStatus::Ok)
+                    {
+                        index.entries_.push_back({pos, static_cast<uint16_t>(consumed), view.type});
+                    }
+                    pos += consumed;
+                }
+
+                if (converged)
+                {
+                    index.entries_.insert(index.entries_.end(), next, frames.end());
+                    pos = results[i].end;
+                }
+            }
+
+            uint64_t covered = 0;
+            for (const auto &entry : index.entries_)
+            {
+                covered += entry.size;
+            }
+            index.skipped_bytes_ = size - covered;
+            return index;
+        }
+
+        size_t size() const { return entries_.size(); }
+        bool empty() const { return entries_.empty(); }
+        const FrameIndexEntry &operator[](size_t n) const { return entries_[n]; }
+        const std::vector<FrameIndexEntry> &entries() const { return entries_; }
+        uint64_t skipped_bytes() const { return skipped_bytes_; }
+
+        // Random access: view of frame N inside the stream the index was built from
+        FrameView frame(const uint8_t *data, size_t n) const
+        {
+            const FrameIndexEntry &entry = entries_[n];
+            FrameView view;
+            view.type = entry.type;
+            view.payload = data + entry.offset + 4;
+            view.payload_size = entry.size - FRAME_OVERHEAD;
+            return view;
+        }
+
+        // Store the index next to the stream.
+        // Format: [COUNT (8 bytes)] + [SKIPPED BYTES (8)] + COUNT * [OFFSET (8) + SIZE (2) + TYPE (1)], little-endian.
+        bool save(const char *path) const
+        {
+            std::FILE *file = std::fopen(path, "wb");
+            if (file == nullptr)
+            {
+                return false;
+            }
+            uint8_t header[INDEX_HEADER_SIZE];
+            capture::store_le(header, entries_.size(), 8);
+            capture::store_le(header + 8, skipped_bytes_, 8);
+            bool ok = std::fwrite(header, 1, sizeof(header), file) == sizeof(header);
+            uint8_t record[INDEX_RECORD_SIZE];
+            for (size_t i = 0; ok && i < entries_.size(); ++i)
+            {
+                capture::store_le(record, entries_[i].offset, 8);
+                capture::store_le(record + 8, entries_[i].size, 2);
+                record[10] = entries_[i].type;
+                ok = std::fwrite(record, 1, sizeof(record), file) == sizeof(record);
+            }
+            return std::fclose(file) == 0 && ok;
+        }
+
+        // Load an index written by save(). Returns false (and leaves the index empty) on I/O error,
+        // a truncated file, a COUNT that does not match the file size or an entry with an impossible frame size.
+        bool load(const char *path)
+        {
+            entries_.clear();
+            skipped_bytes_ = 0;
+            std::FILE *file = std::fopen(path, "rb");
+            if (file == nullptr)
+            {
+                return false;
+            }
+
+            // COUNT comes from the file: check it against the file size before allocating for it
+            bool ok = std::fseek(file, 0, SEEK_END) == 0;
+            long file_size = ok ? std::ftell(file) : -1;
+            ok = file_size >= static_cast<long>(INDEX_HEADER_SIZE) && std::fseek(file, 0, SEEK_SET) == 0;
+
+            uint8_t header[INDEX_HEADER_SIZE];
+            ok = ok && std::fread(header, 1, sizeof(header), file) == sizeof(header);
+            uint64_t count = ok ? capture::load_le(header, 8) : 0;
+            uint64_t skipped = ok ? capture::load_le(header + 8, 8) : 0;
+            ok = ok && count == (static_cast<uint64_t>(file_size) - INDEX_HEADER_SIZE) / INDEX_RECORD_SIZE;
+            if (ok)
+            {
+                entries_.reserve(static_cast<size_t>(count));
+            }
+            uint8_t record[INDEX_RECORD_SIZE];
+            for (uint64_t i = 0; ok && i < count; ++i)
+            {
+                ok = std::fread(record, 1, sizeof(record), file) == sizeof(record);
+                uint16_t size = ok ? static_cast<uint16_t>(capture::load_le(record + 8, 2)) : 0;
+                ok = ok && size >= FRAME_OVERHEAD && size <= MAX_FRAME_SIZE;
+                if (ok)
+                {
+                    entries_.push_back({capture::load_le(record, 8), size, record[10]});
+                }
+            }
+            std::fclose(file);
+            if (!ok)
+            {
+                entries_.clear();
+                return false;
+            }
+            skipped_bytes_ = skipped;
+            return true;
+        }
+    };
+
+    namespace capture
+    {
+        // Concatenate one direction of a capture into a contiguous stream for FrameIndex::build()
+        inline std::vector<uint8_t> collect_stream(CaptureReader &reader, Direction direction)
+        {
+            std::vector<uint8_t> stream;
+            stream.reserve(reader.size());
+            Record record;
+            reader.rewind();
+            while (reader.next(record))
+            {
+                if (record.direction == direction)
+                {
+                    stream.insert(stream.end(), record.data, record.data + record.size);
+                }
+            }
+            return stream;
+        }
+    } // namespace capture
+} // namespace uart_protocol
@@ -2,6 +2,7 @@
 #include <cstdint> // uint8_t, uint32_t...
 #include <cstddef> // size_t
 #include <vector>
+#include <type_traits>
 
 /*
  * Uart - Transport abstraction for the library.
@@ -16,6 +17,11 @@
  *  - receive_data(...) -> read available bytes into buffer (non-blocking recommended)
  *
  * Implementations can use interrupts/DMA internally but expose this minimal, testable API.
+ *
+ * Components that talk to a driver are templated on the driver type (see BasicProtocol<UartT>).
+ * They reach it through uart_send_data()/uart_receive_data() below, which keep the virtual call for
+ * the abstract Uart (and any driver a subclass could override) and resolve the call statically for a
+ * final or non-virtual driver type.
  */
 
 namespace uart_protocol
@@ -40,4 +46,47 @@ namespace uart_protocol
         // Non-blocking: return 0 if no data available.
         virtual size_t receive_data(uint8_t *out_buffer, size_t max_bytes) = 0;
     };
+
+    // Compile-time check that a type provides the Uart member functions (init/deinit/send_data/receive_data).
+    template <typename T, typename = void>
+    struct is_uart_transport : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct is_uart_transport<T, std::void_t<
+                                    decltype(std::declval<T &>().init()),
+                                    decltype(std::declval<T &>().deinit()),
+                                    decltype(std::declval<T &>().send_data(std::declval<const uint8_t *>(), size_t{})),
+                                    decltype(std::declval<T &>().receive_data(std::declval<uint8_t *>(), size_t{}))>>
+        : std::bool_constant<std::is_convertible_v<decltype(std::declval<T &>().send_data(std::declval<const uint8_t *>(), size_t{})), bool> &&
+                             std::is_convertible_v<decltype(std::declval<T &>().receive_data(std::declval<uint8_t *>(), size_t{})), size_t>>
+    {
+    };
+
+    // A driver call can be bound at compile-time when no subclass can override it: the driver type is
+    // final, or it has no virtual functions at all. Otherwise the object may be a subclass of UartT.
+    template <typename UartT>
+    inline constexpr bool is_statically_bound_v = std::is_final_v<UartT> || !std::is_polymorphic_v<UartT>;
+
+    // Send through a driver. For a final (or non-virtual) driver type the qualified call bypasses the
+    // vtable, for the abstract Uart interface and any other overridable type it stays a virtual call.
+    template <typename UartT>
+    inline bool uart_send_data(UartT &uart, const uint8_t *data, size_t size)
+    {
+        if constexpr (is_statically_bound_v<UartT>)
+            return uart.UartT::send_data(data, size);
+        else
+            return uart.send_data(data, size);
+    }
+
+    // Receive through a driver, same binding rules as uart_send_data().
+    template <typename UartT>
+    inline size_t uart_receive_data(UartT &uart, uint8_t *out_buffer, size_t max_bytes)
+    {
+        if constexpr (is_statically_bound_v<UartT>)
+            return uart.UartT::receive_data(out_buffer, max_bytes);
+        else
+            return uart.receive_data(out_buffer, max_bytes);
+    }
 } // namespace uart_protocol
\ No newline at end of file
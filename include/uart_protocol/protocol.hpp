@@ -3,22 +3,169 @@
 #include "ProtocolConfig.hpp"
 #include "frame_utility.hpp"
 #include "timing_utility.hpp"
+#include "frame_trace.hpp"
+#include <cstring>
 #include <vector>
 
 /*
  * UART Protocol - Protocol layer implementation for UART communication.
  * This class provides methods to send and receive framed data over UART using the Uart interface.
- * It handles high-level operations: send_frame, wait_ack, send_start_word, etc.
+ * It handles high-level operations: send_frame, wait_ack, send_start_word, receive_frames, etc.
  * This implementation is portable across platforms using the timing_utility abstraction.
+ *
+ * Transport binding:
+ *  - BasicProtocol<Uart>      -> dynamic binding, every driver call goes through the Uart vtable.
+ *                                `Protocol` is an alias for this instantiation (the original API).
+ *  - BasicProtocol<MyDriver>  -> static binding, driver calls are resolved at compile-time so the
+ *                                driver's send/receive fast path can be inlined into the parser loop.
+ *                                MyDriver may derive from Uart or just provide the same member functions;
+ *                                calls are only bound statically if MyDriver is final or non-virtual.
+ *
+ * Prioritized TX is opt-in through the transport: BasicProtocol<ScheduledUart<MyDriver>> (tx_scheduler.hpp)
+ * queues every frame by class and writes from one drain point, control frames (ACK, ...) first.
  */
 namespace uart_protocol
 {
-    class Protocol
+    template <typename UartT>
+    class BasicProtocol
     {
+        static_assert(is_uart_transport<UartT>::value, "UartT must provide init(), deinit(), send_data() and receive_data()");
+
     private:
-        uart_protocol::Uart &uart_;
+        UartT &uart_;
+
+        // Batch receive buffer: bytes before rx_consumed_ back the views returned by the last receive_frames()
+        std::vector<uint8_t> rx_buffer_;
+        size_t rx_size_ = 0;
+        size_t rx_consumed_ = 0;
+        static_assert(config::RX_BATCH_BUFFER_SIZE >= 2 * MAX_FRAME_SIZE, "RX_BATCH_BUFFER_SIZE must hold a frame behind a partial one");
+
+        // Drop what the last receive_frames() handed out (single compaction), then drain the driver.
+        // trace_id is the frame waiting for its ACK (0 outside of wait_ack()).
+        void fill_rx_buffer([[maybe_unused]] uint32_t trace_id = 0)
+        {
+            if (rx_buffer_.empty())
+            {
+                rx_buffer_.resize(config::RX_BATCH_BUFFER_SIZE);
+            }
+            uint8_t *data = rx_buffer_.data();
+
+            if (rx_consumed_ > 0)
+            {
+                std::memmove(data, data + rx_consumed_, rx_size_ - rx_consumed_);
+                rx_size_ -= rx_consumed_;
+                rx_consumed_ = 0;
+            }
+
+            size_t buffered = rx_size_;
+            while (rx_size_ < rx_buffer_.size())
+            {
+                size_t n = uart_receive_data(uart_, data + rx_size_, rx_buffer_.size() - rx_size_);
+                if (n == 0)
+                {
+                    break;
+                }
+                rx_size_ += n;
+            }
+            if (buffered == 0 && rx_size_ > 0)
+            {
+                UART_PROTOCOL_TRACE(FirstRxByte, trace_id, 0, rx_size_);
+            }
+        }
+
+        // Poll the driver for an ACK frame until the timeout (64-bit microsecond clock) expires.
+        // Only the ACK is taken out of the receive buffer: frames received before or after it stay
+        // buffered for the next receive_frames() call. trace_id is the frame the ACK answers; it is passed
+        // explicitly so sends from other threads (ConcurrentSendUart, ScheduledUart) cannot relabel it.
+        bool wait_ack(uint64_t timeout_us, [[maybe_unused]] uint32_t trace_id)
+        {
+            uint64_t start_time = timing::get_tick_us64();
+            size_t scanned = 0; // Buffered bytes already checked (non-ACK frames and garbage), kept in place
+
+            // Wait for ACK frame
+            uint64_t elapsed_us = 0;
+            while ((elapsed_us = timing::get_tick_us64() - start_time) < timeout_us)
+            {
+                fill_rx_buffer(trace_id);
+                uint8_t *data = rx_buffer_.data();
+                bool progress = false;
+                for (;;)
+                {
+                    FrameView frame;
+                    size_t consumed = 0;
+                    ParseStatus status = decode_frame(data + scanned, rx_size_ - scanned, frame, consumed);
+                    if (status == ParseStatus::NeedMoreData)
+                    {
+                        break;
+                    }
+                    if (status == ParseStatus::Ok)
+                    {
+                        UART_PROTOCOL_TRACE(Parsed, trace_id, frame.type, frame.payload_size);
+
+                        // Check if the received frame is an ACK
+                        if (frame.type == config::ACK_TYPE)
+                        {
+                            UART_PROTOCOL_TRACE(AckMatched, trace_id, frame.type, 0);
+                            std::memmove(data + scanned, data + scanned + consumed, rx_size_ - scanned - consumed);
+                            rx_size_ -= consumed;
+                            return true; // ACK received
+                        }
+                    }
+                    scanned += consumed;
+                    progress = true;
+                }
+
+                if (rx_size_ == rx_buffer_.size())
+                {
+                    // Buffer full of frames nobody has read yet: drop the oldest to keep listening for the ACK
+                    rx_consumed_ = scanned;
+                    scanned = 0;
+                }
+                else if (!progress)
+                {
+                    // No complete frame yet: really sleep (delay_us spins short waits), only a sub-millisecond
+                    // remainder of the deadline is waited out with delay_us
+                    uint64_t remaining_us = timeout_us - elapsed_us;
+                    if (remaining_us >= 1000u * config::RX_POLL_INTERVAL_MS)
+                    {
+                        timing::delay_ms(config::RX_POLL_INTERVAL_MS);
+                    }
+                    else
+                    {
+                        timing::delay_us(static_cast<uint32_t>(remaining_us));
+                    }
+                }
+            }
+            return false; // Timeout waiting for ACK
+        }
+
+        // Send paths take the frame's trace ID as an argument: it lives on the caller's stack, not in the
+        // protocol, so concurrent senders each keep their own
+        bool send_encoded_traced(const uint8_t *frame, size_t frame_size, [[maybe_unused]] uint32_t trace_id)
+        {
+            if (frame_size < FRAME_OVERHEAD || frame_size > MAX_FRAME_SIZE)
+            {
+                return false;
+            }
+            UART_PROTOCOL_TRACE(Encoded, trace_id, frame[3], frame_size);
+            UART_PROTOCOL_TRACE(SendData, trace_id, frame[3], frame_size);
+            return uart_send_data(uart_, frame, frame_size);
+        }
+
+        bool send_frame_traced(uint8_t type, const uint8_t *payload, size_t payload_len, uint32_t trace_id)
+        {
+            if (payload_len > config::MAX_PAYLOAD_SIZE)
+            {
+                return false;
+            }
+            uint8_t raw_frame[MAX_FRAME_SIZE];
+            size_t frame_size = encode_frame(type, payload, payload_len, raw_frame);
+            return send_encoded_traced(raw_frame, frame_size, trace_id);
+        }
 
     public:
+        using uart_type = UartT;
+
         bool init()
         {
             return uart_.init();
@@ -31,15 +178,32 @@ namespace uart_protocol
         // The `explicit` keyword is used to prevent implicit conversions and copy-initialization.
         // It ensures that the constructor cannot be called with a single argument implicitly,
         // which helps avoid unintentional conversions that might lead to bugs.
-        explicit Protocol(uart_protocol::Uart &uart) : uart_(uart) {}
+        explicit BasicProtocol(UartT &uart) : uart_(uart) {}
 
         // Send a framed data packet over UART.
         // Returns true if the frame was successfully sent.
         bool send_frame(uint8_t type, const std::vector<uint8_t> &payload)
         {
-            Frame frame = {type, payload};
-            auto raw_frame = construct_frame(frame);
-            return uart_.send_data(raw_frame.data(), raw_frame.size());
+            return send_frame(type, payload.data(), payload.size());
+        }
+
+        // Send a framed data packet from a raw payload buffer. The frame is encoded on the stack (no allocation).
+        // Returns false if the payload is larger than config::MAX_PAYLOAD_SIZE or the driver refused the frame.
+        bool send_frame(uint8_t type, const uint8_t *payload, size_t payload_len)
+        {
+            return send_frame_traced(type, payload, payload_len, UART_PROTOCOL_TRACE_FRAME_ID());
+        }
+
+        /*
+         * Send a frame the caller already encoded (e.g. encode_message()), without copying it again.
+         * Traced like send_frame().
+         * @param frame Complete frame: START_WORD, LEN, TYPE, payload, CRC16.
+         * @param frame_size Must be between FRAME_OVERHEAD and MAX_FRAME_SIZE.
+         * @return false if the size is out of range or the driver refused the frame.
+         */
+        bool send_encoded(const uint8_t *frame, size_t frame_size)
+        {
+            return send_encoded_traced(frame, frame_size, UART_PROTOCOL_TRACE_FRAME_ID());
         }
 
         /*
@@ -53,59 +217,30 @@ namespace uart_protocol
         bool send_frame_wait_ack(uint8_t type, const std::vector<uint8_t> &payload, uint32_t timeout_ms = config::DEFAULT_ACK_TIMEOUT_MS)
         {
             // Send the frame first
-            if (!send_frame(type, payload))
+            uint32_t trace_id = UART_PROTOCOL_TRACE_FRAME_ID();
+            if (!send_frame_traced(type, payload.data(), payload.size(), trace_id))
             {
                 return false;
             }
+            return wait_ack(static_cast<uint64_t>(timeout_ms) * 1000u, trace_id);
+        }
 
-            uint32_t start_time = timing::get_tick_ms();
-            std::vector<uint8_t> recv_buffer;
-            recv_buffer.reserve(config::MAX_PAYLOAD_SIZE + 10); // Reserve buffer space to avoid multiple allocations
-
-            uint8_t temp_buffer[64]; // Temporary buffer for receiving data
-
-            // Wait for ACK frame
-            while (!timing::has_elapsed(start_time, timeout_ms))
+        /*
+         * Send a framed data packet and wait for an ACK frame, with a microsecond timeout.
+         * Use this for sub-millisecond ACK deadlines on fast links.
+         * @param type Frame type to send.
+         * @param payload Payload data to send.
+         * @param timeout_us Timeout in microseconds to wait for the ACK.
+         * @return true if ACK received, false on timeout or error.
+         */
+        bool send_frame_wait_ack_us(uint8_t type, const std::vector<uint8_t> &payload, uint32_t timeout_us)
+        {
+            uint32_t trace_id = UART_PROTOCOL_TRACE_FRAME_ID();
+            if (!send_frame_traced(type, payload.data(), payload.size(), trace_id))
             {
-                size_t n = uart_.receive_data(temp_buffer, sizeof(temp_buffer));
-
-                if (n > 0)
-                {
-                    recv_buffer.insert(recv_buffer.end(), temp_buffer, temp_buffer + n);
-
-                    // Try to parse frames from the received buffer
-                    Frame received_frame;
-                    size_t consumed_bytes = 0;
-                    
-                    while (parse_frame(recv_buffer, received_frame, consumed_bytes))
-                    {
-                        // Remove consumed bytes from buffer
-                        recv_buffer.erase(recv_buffer.begin(), recv_buffer.begin() + consumed_bytes);
-                        
-                        // Check if the received frame is an ACK
-                        if (received_frame.type == config::ACK_TYPE)
-                        {
-                            return true; // ACK received
-                        }
-                        
-                        // Reset for next iteration
-                        consumed_bytes = 0;
-                    }
-                    
-                    // Prevent buffer from growing too large (in case of corrupt data)
-                    if (recv_buffer.size() > config::MAX_PAYLOAD_SIZE * 2)
-                    {
-                        // Clear buffer if it gets too large (corrupt data)
-                        recv_buffer.clear();
-                    }
-                }
-                else
-                {
-                    // No data received, sleep briefly to avoid busy-waiting
-                    timing::delay_ms(10);
-                }
+                return false;
             }
-            return false; // Timeout waiting for ACK
+            return wait_ack(timeout_us, trace_id);
         }
 
         // Send START_WORD over UART. No payload, just the start word.
@@ -119,5 +254,27 @@ namespace uart_protocol
         {
             return send_frame(config::ACK_TYPE, {});
         }
+
+        /*
+         * Receive every complete frame the driver has delivered, in one pass.
+         * The receive buffer is compacted once per call instead of once per frame, so bursts of small
+         * frames cost one driver drain, one decode pass and one memmove. Garbage and CRC errors are skipped.
+         * Frames that arrived while send_frame_wait_ack() was waiting are returned here too (the ACK is not).
+         * @param out Receives a view for each frame, in stream order. The views point into the protocol's
+         *            receive buffer and stay valid until the next receive_frames() or wait-for-ACK call.
+         * @param max_frames Capacity of `out`; frames that do not fit are returned by the next call.
+         * @return Number of frames written to `out`.
+         */
+        size_t receive_frames(FrameView *out, size_t max_frames)
+        {
+            fill_rx_buffer();
+            return decode_frames(rx_buffer_.data(), rx_size_, out, max_frames, rx_consumed_);
+        }
+
+        // Access to the bound transport
+        UartT &uart() { return uart_; }
     };
+
+    // Default protocol: dynamically bound to the abstract Uart interface.
+    using Protocol = BasicProtocol<Uart>;
 } // namespace uart_protocol
@@ -0,0 +1,340 @@
+#pragma once
+#include "ProtocolConfig.hpp"
+
+#if configUSE_NON_BLOCKING_API
+#include "peripheral.hpp"
+#include "frame_utility.hpp"
+#include "protocol.hpp"
+#include "stream_decoder.hpp"
+#include "timing_utility.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/*
+ * Protocol Engine - Non-blocking, step-driven protocol layer (configUSE_NON_BLOCKING_API).
+ *
+ * For super-loop firmware and event loops: nothing here waits. The application calls step(now) (or
+ * poll()) as often as it likes, and every call does a bounded amount of work:
+ *  - fires the ACK timeout if it is due (retransmit or fail). Only one frame waits for an ACK at a
+ *    time, so this is a single deadline compare, independent of how long the loop stalled
+ *  - reads at most config::ENGINE_RX_BUDGET bytes from the driver and decodes them (StreamDecoder)
+ *  - sends at most one frame
+ *
+ * send() queues a frame and returns a handle immediately. Frames go out one at a time and wait for
+ * an ACK (stop-and-wait, like send_frame_wait_ack()), a missing ACK is retransmitted up to
+ * config::ENGINE_MAX_RETRIES times. The outcome is reported through the completion callback and
+ * can also be queried with status(handle). Received frames other than ACKs go to the frame handler.
+ *
+ * ACKs carry no sequence number. When the frame on the wire is cancelled, its ACK may still arrive,
+ * so the next frame is held back until that ACK comes in (it is swallowed) or the cancelled frame's
+ * ACK deadline passes, whichever is first. A late ACK can therefore never complete the next frame.
+ *
+ * last_step_us()/max_step_us() measure the CPU time spent inside step(), so the worst case can be
+ * checked against the loop budget.
+ *
+ * Note: Not internally synchronized. Callbacks run inside step() and may call send()/cancel().
+ *
+ * Usage:
+ *   uart_protocol::ProtocolEngine<MyUart> engine(protocol);
+ *   engine.set_frame_handler(on_frame, &app);
+ *   auto handle = engine.send(config::DATA_TYPE, data, len, on_sent, &app);
+ *   for (;;) { engine.poll(); do_other_work(); }
+ */
+
+namespace uart_protocol
+{
+    using SendHandle = uint32_t; // 0 is never a valid handle
+
+    enum class SendStatus : uint8_t
+    {
+        Queued,      // Waiting for its turn
+        AwaitingAck, // Sent, ACK timer running
+        Acked,       // ACK received
+        Failed,      // No ACK after all retransmits
+        Cancelled,   // Cancelled by the application
+        Unknown      // Handle not known (never issued or slot reused)
+    };
+
+    // Completion callback of send()
+    using SendCallback = void (*)(void *context, SendHandle handle, SendStatus status);
+    // Handler for received frames other than ACK. The payload is only valid during the call.
+    using FrameHandler = void (*)(void *context, const FrameView &frame);
+
+    template <typename UartT, size_t QueueDepth = config::ENGINE_QUEUE_DEPTH>
+    class ProtocolEngine
+    {
+        static_assert(QueueDepth > 0, "QueueDepth must be at least 1");
+
+    private:
+        struct Entry
+        {
+            SendHandle handle = 0;
+            SendStatus status = SendStatus::Unknown;
+            uint8_t type = 0;
+            uint8_t retries = 0;
+            uint8_t length = 0;
+            uint8_t payload[config::MAX_PAYLOAD_SIZE];
+            SendCallback callback = nullptr;
+            void *context = nullptr;
+        };
+
+        BasicProtocol<UartT> &protocol_;
+        StreamDecoder decoder_;
+        uint32_t now_ms_;                 // Time passed to the last step()
+        uint32_t ack_deadline_ms_ = 0;    // When the head frame's ACK is overdue
+        bool ack_armed_ = false;
+        bool ack_hold_ = false;           // In-flight frame was cancelled: wait for its ACK or deadline before sending
+        uint32_t ack_timeout_ms_ = config::DEFAULT_ACK_TIMEOUT_MS;
+
+        Entry entries_[QueueDepth]; // FIFO, entries_[head_] is the frame on the wire
+        size_t head_ = 0;
+        size_t count_ = 0;
+        SendHandle next_handle_ = 1;
+        bool send_due_ = false; // Head entry needs a (re)transmission
+
+        FrameHandler frame_handler_ = nullptr;
+        void *frame_context_ = nullptr;
+
+        uint32_t last_step_us_ = 0;
+        uint32_t max_step_us_ = 0;
+        uint64_t retransmits_ = 0;
+
+        Entry *find(SendHandle handle)
+        {
+            for (auto &entry : entries_)
+            {
+                if (handle != 0 && entry.handle == handle)
+                {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+
+        // Finish the head entry and move on to the next frame
+        void complete_head(SendStatus status)
+        {
+            ack_armed_ = false;
+            Entry &entry = entries_[head_];
+            entry.status = status;
+            head_ = (head_ + 1) % QueueDepth;
+            --count_;
+            send_due_ = count_ > 0;
+            if (entry.callback != nullptr)
+            {
+                entry.callback(entry.context, entry.handle, status);
+            }
+        }
+
+        void on_ack_timeout()
+        {
+            ack_armed_ = false;
+            Entry &entry = entries_[head_];
+            if (entry.retries < config::ENGINE_MAX_RETRIES)
+            {
+                ++entry.retries;
+                ++retransmits_;
+                send_due_ = true;
+            }
+            else
+            {
+                complete_head(SendStatus::Failed);
+            }
+        }
+
+        void on_frame(const FrameView &frame)
+        {
+            if (frame.type == config::ACK_TYPE)
+            {
+                if (ack_hold_)
+                {
+                    ack_hold_ = false; // ACK of the cancelled frame: the next frame may go out now
+                    return;
+                }
+                if (count_ > 0 && entries_[head_].status == SendStatus::AwaitingAck)
+                {
+                    complete_head(SendStatus::Acked);
+                }
+                return; // Late or duplicate ACK
+            }
+            if (frame_handler_ != nullptr)
+            {
+                frame_handler_(frame_context_, frame);
+            }
+        }
+
+        void transmit_head()
+        {
+            // Skip frames cancelled while queued
+            while (count_ > 0 && entries_[head_].status == SendStatus::Cancelled)
+            {
+                head_ = (head_ + 1) % QueueDepth;
+                --count_;
+            }
+            if (count_ == 0)
+            {
+                send_due_ = false;
+                return;
+            }
+            Entry &entry = entries_[head_];
+            if (!protocol_.send_frame(entry.type, entry.payload, entry.length))
+            {
+                return; // Driver busy: try again next step
+            }
+            entry.status = SendStatus::AwaitingAck;
+            send_due_ = false;
+            ack_deadline_ms_ = now_ms_ + ack_timeout_ms_;
+            ack_armed_ = true;
+        }
+
+    public:
+        explicit ProtocolEngine(BasicProtocol<UartT> &protocol) : protocol_(protocol), now_ms_(timing::get_tick_ms()) {}
+
+        ProtocolEngine(const ProtocolEngine &) = delete;
+        ProtocolEngine &operator=(const ProtocolEngine &) = delete;
+
+        /*
+         * Queue a frame to be sent and ACKed. Never blocks.
+         * @param type Frame type.
+         * @param payload Payload bytes (copied, at most config::MAX_PAYLOAD_SIZE).
+         * @param len Payload size.
+         * @param callback Called from step() with Acked, Failed or Cancelled (may be nullptr).
+         * @param context User pointer passed to the callback.
+         * @return Handle for status()/cancel(), 0 if the queue is full or the payload too large.
+         */
+        SendHandle send(uint8_t type, const uint8_t *payload, size_t len, SendCallback callback = nullptr, void *context = nullptr)
+        {
+            if (count_ == QueueDepth || len > config::MAX_PAYLOAD_SIZE)
+            {
+                return 0;
+            }
+            Entry &entry = entries_[(head_ + count_) % QueueDepth];
+            entry.handle = next_handle_;
+            next_handle_ = next_handle_ == UINT32_MAX ? 1 : next_handle_ + 1;
+            entry.status = SendStatus::Queued;
+            entry.type = type;
+            entry.retries = 0;
+            entry.length = static_cast<uint8_t>(len);
+            if (len > 0)
+            {
+                std::memcpy(entry.payload, payload, len);
+            }
+            entry.callback = callback;
+            entry.context = context;
+            if (count_++ == 0)
+            {
+                send_due_ = true;
+            }
+            return entry.handle;
+        }
+
+        // Send a frame right away without ACK tracking (e.g. an ACK for a received frame)
+        bool send_unacked(uint8_t type, const uint8_t *payload, size_t len)
+        {
+            return protocol_.send_frame(type, payload, len);
+        }
+
+        bool send_ack()
+        {
+            return protocol_.send_ack();
+        }
+
+        /*
+         * Cancel a queued or unacknowledged frame. The callback runs with SendStatus::Cancelled.
+         * Cancelling the frame on the wire holds the next transmission until its ACK arrives or its
+         * ACK deadline passes, so that ACK is not taken for the next frame's.
+         */
+        bool cancel(SendHandle handle)
+        {
+            Entry *entry = find(handle);
+            if (entry == nullptr || (entry->status != SendStatus::Queued && entry->status != SendStatus::AwaitingAck))
+            {
+                return false;
+            }
+            if (entry == &entries_[head_])
+            {
+                bool in_flight = entry->status == SendStatus::AwaitingAck;
+                complete_head(SendStatus::Cancelled);
+                ack_hold_ = in_flight; // ack_deadline_ms_ still holds the cancelled frame's deadline
+                return true;
+            }
+            entry->status = SendStatus::Cancelled; // Skipped when it reaches the head
+            if (entry->callback != nullptr)
+            {
+                entry->callback(entry->context, entry->handle, SendStatus::Cancelled);
+            }
+            return true;
+        }
+
+        // Current state of a frame. Final states stay readable until the slot is reused.
+        SendStatus status(SendHandle handle) const
+        {
+            Entry *entry = const_cast<ProtocolEngine *>(this)->find(handle);
+            return entry != nullptr ? entry->status : SendStatus::Unknown;
+        }
+
+        void set_frame_handler(FrameHandler handler, void *context)
+        {
+            frame_handler_ = handler;
+            frame_context_ = context;
+        }
+
+        void set_ack_timeout_ms(uint32_t timeout_ms) { ack_timeout_ms_ = timeout_ms > 0 ? timeout_ms : 1; }
+
+        /*
+         * Advance the engine by one bounded step.
+         * @param now_ms Current time in milliseconds (same clock as timing::get_tick_ms()).
+         * @return Number of frames received (including ACKs) in this step.
+         */
+        size_t step(uint32_t now_ms)
+        {
+            uint32_t start_us = timing::get_tick_us();
+
+            now_ms_ = now_ms;
+            bool deadline_passed = static_cast<int32_t>(now_ms - ack_deadline_ms_) >= 0;
+            if (ack_armed_ && deadline_passed)
+            {
+                on_ack_timeout();
+            }
+            if (ack_hold_ && deadline_passed)
+            {
+                ack_hold_ = false; // The cancelled frame's ACK is overdue, a later ACK belongs to the next frame
+            }
+
+            uint8_t rx[config::ENGINE_RX_BUDGET];
+            size_t received = 0;
+            size_t n = uart_receive_data(protocol_.uart(), rx, sizeof(rx));
+            if (n > 0)
+            {
+                received = decoder_.feed(rx, n, [this](const FrameView &frame)
+                                         { on_frame(frame); });
+            }
+
+            if (send_due_ && !ack_hold_)
+            {
+                transmit_head();
+            }
+
+            last_step_us_ = timing::get_elapsed_us(start_us);
+            max_step_us_ = last_step_us_ > max_step_us_ ? last_step_us_ : max_step_us_;
+            return received;
+        }
+
+        // step() with the platform millisecond clock
+        size_t poll()
+        {
+            return step(timing::get_tick_ms());
+        }
+
+        size_t pending() const { return count_; }
+        bool idle() const { return count_ == 0; }
+        uint64_t retransmits() const { return retransmits_; }
+
+        uint32_t last_step_us() const { return last_step_us_; }
+        uint32_t max_step_us() const { return max_step_us_; }
+        void reset_step_stats() { max_step_us_ = 0; }
+    };
+} // namespace uart_protocol
+
+#endif // configUSE_NON_BLOCKING_API
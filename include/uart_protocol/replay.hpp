@@ -0,0 +1,212 @@
+#pragma once
+#include "capture.hpp"
+#include "frame_utility.hpp"
+#include "stream_decoder.hpp"
+#include "timing_utility.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+/*
+ * Replay - Feed a recorded capture back into decoders or through a Uart.
+ *
+ *  - replay_decode(): pushes one direction of a capture through a decoder as fast as possible and
+ *    reports frames/s and GB/s. A decoder is any callable `size_t(const uint8_t *data, size_t len)`
+ *    returning the number of frames it decoded from the chunk (see StreamChunkDecoder, ParseFrameDecoder).
+ *  - ReplayUart: a Uart whose receive_data() returns the captured bytes with their original timing
+ *    (optionally sped up), to reproduce field issues against the real protocol stack.
+ *
+ * Usage:
+ *   uart_protocol::MappedFile file;             // porting/posix/mapped_file.hpp
+ *   file.open("link.upcap");
+ *   uart_protocol::capture::CaptureReader reader(file.data(), file.size());
+ *   auto stats = uart_protocol::capture::replay_decode(reader, Direction::Rx, StreamChunkDecoder{});
+ */
+
+namespace uart_protocol::capture
+{
+    struct ReplayStats
+    {
+        uint64_t records = 0;
+        uint64_t bytes = 0;
+        uint64_t frames = 0;
+        double seconds = 0.0;
+
+        double frames_per_second() const { return seconds > 0.0 ? static_cast<double>(frames) / seconds : 0.0; }
+        double gigabytes_per_second() const { return seconds > 0.0 ? static_cast<double>(bytes) / seconds / 1e9 : 0.0; }
+    };
+
+    // Zero-copy decoder built on StreamDecoder
+    class StreamChunkDecoder
+    {
+    private:
+        StreamDecoder decoder_;
+
+    public:
+        size_t operator()(const uint8_t *data, size_t len)
+        {
+            return decoder_.feed(data, len, [](const FrameView &) {});
+        }
+
+        const StreamDecoder &decoder() const { return decoder_; }
+    };
+
+    // Reference decoder: the std::vector based parse_frame() loop used by Protocol::send_frame_wait_ack
+    class ParseFrameDecoder
+    {
+    private:
+        std::vector<uint8_t> buffer_;
+
+    public:
+        size_t operator()(const uint8_t *data, size_t len)
+        {
+            buffer_.insert(buffer_.end(), data, data + len);
+            size_t frames = 0;
+            Frame frame;
+            size_t consumed = 0;
+            while (!buffer_.empty())
+            {
+                if (parse_frame(buffer_, frame, consumed))
+                {
+                    buffer_.erase(buffer_.begin(), buffer_.begin() + consumed);
+                    ++frames;
+                    continue;
+                }
+                // parse_frame() does not resync: drop up to the next START_WORD if the head is not a frame start
+                FrameView view;
+                if (decode_frame(buffer_.data(), buffer_.size(), view, consumed) != ParseStatus::Invalid)
+                {
+                    break;
+                }
+                buffer_.erase(buffer_.begin(), buffer_.begin() + consumed);
+            }
+            return frames;
+        }
+    };
+
+    /*
+     * Push every record of one direction through a decoder at full speed.
+     * @param reader Capture to replay (rewound first).
+     * @param direction Direction to replay (usually Rx).
+     * @param decoder Callable `size_t(const uint8_t *, size_t)` returning frames decoded.
+     * @return Bytes, frames and wall time of the replay.
+     */
+    template <typename Decoder>
+    inline ReplayStats replay_decode(CaptureReader &reader, Direction direction, Decoder &&decoder)
+    {
+        ReplayStats stats;
+        Record record;
+        reader.rewind();
+
+        auto start = std::chrono::steady_clock::now();
+        while (reader.next(record))
+        {
+            if (record.direction != direction)
+            {
+                continue;
+            }
+            ++stats.records;
+            stats.bytes += record.size;
+            stats.frames += decoder(record.data, record.size);
+        }
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+
+    /*
+     * ReplayUart - Plays one direction of a capture back as incoming data.
+     * receive_data() only returns bytes whose capture time (relative to the first record, divided by
+     * `speed`) has passed since init(). Frames sent through it are counted and dropped.
+     */
+    class ReplayUart final : public Uart
+    {
+    private:
+        CaptureReader reader_;
+        Direction direction_;
+        double speed_;
+        uint64_t start_us_ = 0;
+        uint64_t first_record_us_ = 0;
+        bool have_first_ = false;
+        Record current_;
+        size_t current_offset_ = 0;
+        bool has_current_ = false;
+        bool finished_ = false;
+        uint64_t tx_bytes_ = 0;
+
+        // Load the next record of the replayed direction
+        bool load_next()
+        {
+            while (reader_.next(current_))
+            {
+                if (current_.direction == direction_)
+                {
+                    if (!have_first_)
+                    {
+                        first_record_us_ = current_.timestamp_us;
+                        have_first_ = true;
+                    }
+                    current_offset_ = 0;
+                    return true;
+                }
+            }
+            finished_ = true;
+            return false;
+        }
+
+    public:
+        // speed 1.0 = original timing, 2.0 = twice as fast
+        explicit ReplayUart(CaptureReader reader, Direction direction = Direction::Rx, double speed = 1.0)
+            : reader_(reader), direction_(direction), speed_(speed > 0.0 ? speed : 1.0)
+        {
+        }
+
+        bool init() override
+        {
+            reader_.rewind();
+            have_first_ = false;
+            finished_ = false;
+            has_current_ = load_next();
+            start_us_ = timing::get_tick_us64();
+            return reader_.valid();
+        }
+
+        void deinit() override {}
+
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            (void)data;
+            tx_bytes_ += size;
+            return true;
+        }
+
+        size_t receive_data(uint8_t *out_buffer, size_t max_bytes) override
+        {
+            size_t copied = 0;
+            uint64_t elapsed_us = timing::get_tick_us64() - start_us_;
+            while (has_current_ && copied < max_bytes)
+            {
+                uint64_t due_us = static_cast<uint64_t>(static_cast<double>(current_.timestamp_us - first_record_us_) / speed_);
+                if (due_us > elapsed_us)
+                {
+                    break; // Not yet "on the wire"
+                }
+                size_t n = current_.size - current_offset_;
+                n = n < max_bytes - copied ? n : max_bytes - copied;
+                std::memcpy(out_buffer + copied, current_.data + current_offset_, n);
+                copied += n;
+                current_offset_ += n;
+                if (current_offset_ == current_.size)
+                {
+                    has_current_ = load_next();
+                }
+            }
+            return copied;
+        }
+
+        // True once every record has been handed out
+        bool finished() const { return finished_ && !has_current_; }
+        uint64_t tx_bytes() const { return tx_bytes_; }
+    };
+} // namespace uart_protocol::capture
@@ -0,0 +1,231 @@
+#pragma once
+#include "peripheral.hpp"
+#include "ProtocolConfig.hpp"
+#include "frame_utility.hpp"
+#include "spsc_ring.hpp"
+#include "stream_decoder.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * RX Ingest - Push-style receive path for interrupt and DMA context.
+ *
+ * Drivers push received bytes instead of the protocol pulling them through Uart::receive_data():
+ *  - on_rx_byte():  from an RX-not-empty interrupt, one byte at a time
+ *  - on_rx_chunk(): any contiguous block of bytes (e.g. a DMA buffer half)
+ *  - on_dma_rx():   half-transfer, transfer-complete and idle-line events of a circular DMA buffer,
+ *                   called with the DMA write position (buffer size - remaining transfer count)
+ *
+ * The interrupt side only copies into an SpscRing and is wait-free: no locks, no loops that depend on
+ * the other side, no allocation. A full ring drops the new bytes and counts them. The optional notify
+ * hook runs after each push, e.g. to wake the RX task with vTaskNotifyGiveFromISR().
+ *
+ * Decoding is deferred to task context: process() decodes buffered bytes with a StreamDecoder,
+ * reading straight from the ring without an extra copy.
+ *
+ * Note: exactly one interrupt context may push and one task may process.
+ *
+ * Usage:
+ *   uart_protocol::RxIngest<> rx;                             // config::RX_INGEST_BUFFER_SIZE bytes
+ *   rx.attach_dma(dma_buffer, sizeof(dma_buffer));
+ *   void USART1_IRQHandler() { rx.on_dma_rx(sizeof(dma_buffer) - DMA1_Channel5->CNDTR); } // HT/TC/IDLE
+ *   rx.process([](const uart_protocol::FrameView &frame) { ... });                          // RX task
+ */
+
+namespace uart_protocol
+{
+    template <size_t Capacity = config::RX_INGEST_BUFFER_SIZE>
+    class RxIngest
+    {
+    public:
+        // Called from interrupt context after bytes were pushed (keep it short and ISR-safe)
+        using NotifyHook = void (*)(void *context);
+
+    private:
+        SpscRing<Capacity> ring_;
+        StreamDecoder decoder_; // Task side only
+
+        // DMA circular buffer (interrupt side only)
+        const volatile uint8_t *dma_buffer_ = nullptr;
+        size_t dma_size_ = 0;
+        size_t dma_read_pos_ = 0;
+
+        NotifyHook notify_ = nullptr;
+        void *notify_context_ = nullptr;
+
+        // Written only by the interrupt side with plain load/store (no read-modify-write, fine on Cortex-M0)
+        std::atomic<uint32_t> rx_bytes_{0};
+        std::atomic<uint32_t> dropped_bytes_{0};
+
+        void account(size_t received, size_t stored)
+        {
+            rx_bytes_.store(rx_bytes_.load(std::memory_order_relaxed) + static_cast<uint32_t>(received), std::memory_order_relaxed);
+            if (stored < received)
+            {
+                dropped_bytes_.store(dropped_bytes_.load(std::memory_order_relaxed) + static_cast<uint32_t>(received - stored),
+                                     std::memory_order_relaxed);
+            }
+            if (notify_ != nullptr && stored > 0)
+            {
+                notify_(notify_context_);
+            }
+        }
+
+        size_t push_dma(size_t from, size_t to)
+        {
+            // The DMA buffer is volatile memory written by hardware: copy byte by byte into the ring
+            size_t stored = 0;
+            for (size_t i = from; i < to; ++i)
+            {
+                if (!ring_.push(static_cast<uint8_t>(dma_buffer_[i])))
+                {
+                    break;
+                }
+                ++stored;
+            }
+            return stored;
+        }
+
+    public:
+        RxIngest() = default;
+        RxIngest(const RxIngest &) = delete;
+        RxIngest &operator=(const RxIngest &) = delete;
+
+        // Set before enabling the interrupt
+        void set_notify(NotifyHook hook, void *context)
+        {
+            notify_ = hook;
+            notify_context_ = context;
+        }
+
+        // Register the circular DMA RX buffer (before starting the transfer)
+        void attach_dma(const volatile uint8_t *buffer, size_t size)
+        {
+            dma_buffer_ = buffer;
+            dma_size_ = size;
+            dma_read_pos_ = 0;
+        }
+
+        // Interrupt context: one received byte. Returns false if the ring was full (byte dropped).
+        bool on_rx_byte(uint8_t byte)
+        {
+            bool stored = ring_.push(byte);
+            account(1, stored ? 1 : 0);
+            return stored;
+        }
+
+        // Interrupt context: a block of received bytes. Returns the number stored (the rest was dropped).
+        size_t on_rx_chunk(const uint8_t *data, size_t len)
+        {
+            size_t stored = ring_.push(data, len);
+            account(len, stored);
+            return stored;
+        }
+
+        /*
+         * Interrupt context: DMA half-transfer, transfer-complete or idle-line event.
+         * Takes every byte written since the previous event, across the buffer end if needed.
+         * @param write_pos DMA write position in the buffer (buffer size - remaining count); dma size and 0 are both
+         *                  accepted for transfer-complete.
+         * @return Number of bytes stored.
+         */
+        size_t on_dma_rx(size_t write_pos)
+        {
+            if (dma_buffer_ == nullptr || write_pos > dma_size_)
+            {
+                return 0;
+            }
+            if (write_pos == dma_size_)
+            {
+                write_pos = 0;
+            }
+            if (write_pos == dma_read_pos_)
+            {
+                return 0;
+            }
+
+            size_t received;
+            size_t stored;
+            if (write_pos > dma_read_pos_)
+            {
+                received = write_pos - dma_read_pos_;
+                stored = push_dma(dma_read_pos_, write_pos);
+            }
+            else
+            {
+                // Wrapped: tail of the buffer, then its start
+                received = dma_size_ - dma_read_pos_ + write_pos;
+                stored = push_dma(dma_read_pos_, dma_size_);
+                if (stored == dma_size_ - dma_read_pos_)
+                {
+                    stored += push_dma(0, write_pos);
+                }
+            }
+            dma_read_pos_ = write_pos;
+            account(received, stored);
+            return stored;
+        }
+
+        /*
+         * Task context: decode buffered bytes.
+         * @param on_frame Called with a FrameView for every complete frame (valid only during the call).
+         * @param max_bytes Upper bound on bytes processed by this call.
+         * @return Number of frames decoded.
+         */
+        template <typename Fn>
+        size_t process(Fn &&on_frame, size_t max_bytes = SIZE_MAX)
+        {
+            size_t frames = 0;
+            while (max_bytes > 0)
+            {
+                size_t contiguous = 0;
+                const uint8_t *data = ring_.peek(contiguous);
+                if (contiguous == 0)
+                {
+                    break;
+                }
+                contiguous = contiguous < max_bytes ? contiguous : max_bytes;
+                frames += decoder_.feed(data, contiguous, on_frame);
+                ring_.consume(contiguous);
+                max_bytes -= contiguous;
+            }
+            return frames;
+        }
+
+        // Task context: copy raw bytes out instead of decoding (for a receive_data()-style consumer)
+        size_t read(uint8_t *out, size_t max_bytes)
+        {
+            return ring_.pop(out, max_bytes);
+        }
+
+        size_t buffered_bytes() const { return ring_.size(); }
+        uint32_t rx_bytes() const { return rx_bytes_.load(std::memory_order_relaxed); }
+        uint32_t dropped_bytes() const { return dropped_bytes_.load(std::memory_order_relaxed); }
+        uint64_t skipped_bytes() const { return decoder_.skipped_bytes(); }
+    };
+
+    /*
+     * IngestUart - Uart whose receive side is fed by an RxIngest (interrupt/DMA), so BasicProtocol
+     * reads interrupt-delivered bytes without polling the hardware. Sending goes to the wrapped driver.
+     */
+    template <typename UartT, size_t Capacity = config::RX_INGEST_BUFFER_SIZE>
+    class IngestUart final : public Uart
+    {
+        static_assert(is_uart_transport<UartT>::value, "UartT must provide init(), deinit(), send_data() and receive_data()");
+
+    private:
+        UartT &uart_;
+        RxIngest<Capacity> &ingest_;
+
+    public:
+        IngestUart(UartT &uart, RxIngest<Capacity> &ingest) : uart_(uart), ingest_(ingest) {}
+
+        bool init() override { return uart_.init(); }
+        void deinit() override { uart_.deinit(); }
+        bool send_data(const uint8_t *data, size_t size) override { return uart_send_data(uart_, data, size); }
+        size_t receive_data(uint8_t *out_buffer, size_t max_bytes) override { return ingest_.read(out_buffer, max_bytes); }
+
+        UartT &uart() { return uart_; }
+    };
+} // namespace uart_protocol
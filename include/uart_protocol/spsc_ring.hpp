@@ -0,0 +1,114 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/*
+ * SPSC Ring - Lock-free single-producer/single-consumer byte ring.
+ *
+ * One context pushes (driver thread, ISR, DMA callback), one context pops (protocol/decoder task).
+ * Both sides are wait-free: no locks, no retries, a bounded number of steps per call.
+ * Read/write indices are free-running counters, the capacity must be a power of two.
+ *
+ * When the ring is full push() stores what fits and returns the stored count, the caller decides
+ * whether to count or signal the overflow.
+ *
+ * Usage:
+ *   uart_protocol::SpscRing<4096> ring;
+ *   ring.push(bytes, n);                 // producer
+ *   size_t got = ring.pop(out, sizeof(out)); // consumer
+ */
+
+namespace uart_protocol
+{
+    template <size_t Capacity>
+    class SpscRing
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    private:
+        static constexpr size_t MASK = Capacity - 1;
+
+        alignas(64) std::atomic<size_t> head_{0}; // Total bytes written (producer owned)
+        alignas(64) std::atomic<size_t> tail_{0}; // Total bytes read (consumer owned)
+        alignas(64) uint8_t buffer_[Capacity];
+
+    public:
+        SpscRing() = default;
+        SpscRing(const SpscRing &) = delete;
+        SpscRing &operator=(const SpscRing &) = delete;
+
+        // Producer: store up to `size` bytes. Returns the number stored (less than size when full).
+        size_t push(const uint8_t *data, size_t size)
+        {
+            size_t head = head_.load(std::memory_order_relaxed);
+            size_t tail = tail_.load(std::memory_order_acquire);
+            size_t free_space = Capacity - (head - tail);
+            size_t n = size < free_space ? size : free_space;
+
+            size_t offset = head & MASK;
+            size_t first = n < Capacity - offset ? n : Capacity - offset;
+            std::memcpy(buffer_ + offset, data, first);
+            std::memcpy(buffer_, data + first, n - first);
+
+            head_.store(head + n, std::memory_order_release);
+            return n;
+        }
+
+        // Producer: store a single byte. Returns false when full.
+        bool push(uint8_t byte)
+        {
+            size_t head = head_.load(std::memory_order_relaxed);
+            if (head - tail_.load(std::memory_order_acquire) == Capacity)
+            {
+                return false;
+            }
+            buffer_[head & MASK] = byte;
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer: copy out up to `max_bytes`. Returns the number copied (0 when empty).
+        size_t pop(uint8_t *out, size_t max_bytes)
+        {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            size_t head = head_.load(std::memory_order_acquire);
+            size_t available = head - tail;
+            size_t n = max_bytes < available ? max_bytes : available;
+
+            size_t offset = tail & MASK;
+            size_t first = n < Capacity - offset ? n : Capacity - offset;
+            std::memcpy(out, buffer_ + offset, first);
+            std::memcpy(out + first, buffer_, n - first);
+
+            tail_.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        // Consumer: contiguous readable region without copying. Release it with consume().
+        const uint8_t *peek(size_t &contiguous) const
+        {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            size_t available = head_.load(std::memory_order_acquire) - tail;
+            size_t offset = tail & MASK;
+            contiguous = available < Capacity - offset ? available : Capacity - offset;
+            return buffer_ + offset;
+        }
+
+        // Consumer: drop `n` bytes returned by peek()
+        void consume(size_t n)
+        {
+            tail_.store(tail_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+        }
+
+        // Bytes waiting to be read (exact for the consumer, a snapshot for anyone else)
+        size_t size() const
+        {
+            return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+        }
+
+        bool empty() const { return size() == 0; }
+        static constexpr size_t capacity() { return Capacity; }
+    };
+} // namespace uart_protocol
@@ -0,0 +1,133 @@
+#pragma once
+#include "frame_utility.hpp"
+#include "frame_trace.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/*
+ * Stream Decoder - Incremental frame decoder for a byte stream that arrives in arbitrary chunks.
+ *
+ * Frames that lie completely inside a chunk are decoded in place (zero-copy FrameView into the chunk).
+ * Only a frame that straddles two chunks is copied into a small fixed carry buffer, and only up to
+ * its end: the rest of the chunk is decoded in place again.
+ * Garbage and CRC errors are skipped by resyncing on the next START_WORD.
+ *
+ * Usage:
+ *   uart_protocol::StreamDecoder decoder;
+ *   decoder.feed(chunk, chunk_len, [](const uart_protocol::FrameView &frame) {
+ *       // frame.payload is only valid inside the callback
+ *   });
+ */
+
+namespace uart_protocol
+{
+    class StreamDecoder
+    {
+    private:
+        uint8_t carry_[MAX_FRAME_SIZE];
+        size_t carry_size_ = 0;
+
+        uint64_t frames_ = 0;
+        uint64_t skipped_bytes_ = 0; // Bytes dropped while resyncing (noise, CRC errors)
+#if configUSE_TRACING
+        uint32_t trace_id_ = 0; // Frame ID of the frame being received
+#endif
+
+        // Decode as many frames as possible from a buffer. Returns the offset of the first undecoded byte.
+        template <typename Fn>
+        size_t decode_buffer(const uint8_t *data, size_t len, Fn &on_frame)
+        {
+            size_t offset = 0;
+            while (offset < len)
+            {
+                FrameView frame;
+                size_t consumed = 0;
+                ParseStatus status = decode_frame(data + offset, len - offset, frame, consumed);
+                if (status == ParseStatus::Ok)
+                {
+                    ++frames_;
+#if configUSE_TRACING
+                    // The first frame of a chunk continues the ID of its first_rx_byte event
+                    UART_PROTOCOL_TRACE(Parsed, trace_id_ != 0 ? trace_id_ : UART_PROTOCOL_TRACE_FRAME_ID(), frame.type, frame.payload_size);
+                    trace_id_ = 0;
+#endif
+                    on_frame(frame);
+                }
+                else if (status == ParseStatus::Invalid)
+                {
+                    skipped_bytes_ += consumed;
+                }
+                else
+                {
+                    break; // NeedMoreData
+                }
+                offset += consumed;
+            }
+            return offset;
+        }
+
+    public:
+        /*
+         * Decode a chunk of the stream.
+         * @param data Chunk bytes.
+         * @param len Chunk size.
+         * @param on_frame Called with a FrameView for every valid frame, in stream order.
+         * @return Number of frames decoded from this call.
+         */
+        template <typename Fn>
+        size_t feed(const uint8_t *data, size_t len, Fn &&on_frame)
+        {
+            uint64_t frames_before = frames_;
+#if configUSE_TRACING
+            if (carry_size_ == 0 && len > 0)
+            {
+                trace_id_ = UART_PROTOCOL_TRACE_FRAME_ID();
+                UART_PROTOCOL_TRACE(FirstRxByte, trace_id_, 0, len);
+            }
+#endif
+
+            // Finish a frame that started in a previous chunk. Only the bytes it still needs are copied:
+            // first its header up to LEN, then the rest of the frame. The carry always starts at a
+            // START_WORD candidate, so a resync leaves another candidate (or nothing) behind.
+            while (carry_size_ > 0 && len > 0)
+            {
+                size_t needed = carry_size_ < 3 ? 3 : FRAME_OVERHEAD + carry_[2];
+                size_t take = needed - carry_size_;
+                take = take < len ? take : len;
+                std::memcpy(carry_ + carry_size_, data, take);
+                carry_size_ += take;
+                data += take;
+                len -= take;
+                if (carry_size_ < needed)
+                {
+                    break; // Chunk exhausted
+                }
+
+                size_t used = decode_buffer(carry_, carry_size_, on_frame);
+                std::memmove(carry_, carry_ + used, carry_size_ - used);
+                carry_size_ -= used;
+            }
+
+            // Decode the rest in place, keep an incomplete tail for the next chunk
+            if (carry_size_ == 0)
+            {
+                size_t used = decode_buffer(data, len, on_frame);
+                std::memcpy(carry_, data + used, len - used);
+                carry_size_ = len - used;
+            }
+
+            return static_cast<size_t>(frames_ - frames_before);
+        }
+
+        // Drop a partially received frame (e.g. after a link reset)
+        void reset()
+        {
+            carry_size_ = 0;
+        }
+
+        uint64_t frames() const { return frames_; }
+        uint64_t skipped_bytes() const { return skipped_bytes_; }
+        size_t buffered_bytes() const { return carry_size_; }
+    };
+} // namespace uart_protocol
@@ -0,0 +1,261 @@
+#pragma once
+#include "ProtocolConfig.hpp"
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * Timer Wheel - Hierarchical timing wheel for many concurrent deadlines.
+ *
+ * Retransmit timers, keep-alives and request deadlines are TimerNode objects embedded in the
+ * structures that own them (intrusive, no allocation). The wheel only links them into slots:
+ *  - schedule()/cancel() are O(1)
+ *  - advance(now) is O(1) per elapsed tick plus the timers that fire or cascade
+ *
+ * Geometry comes from config::TIMER_WHEEL_LEVEL_BITS/TIMER_WHEEL_LEVELS. Level 0 has one slot per
+ * tick, each higher level covers the whole range of the level below in one slot. Timers further away
+ * than the whole wheel are parked in the top level and re-cascaded until they are in range.
+ *
+ * The tick unit is whatever the caller passes to advance(): use timing::get_tick_ms() for millisecond
+ * deadlines. Tick counters are uint32_t and wrap around safely.
+ *
+ * Note: Not internally synchronized. A TimerNode must not be moved or destroyed while it is armed,
+ * and callbacks run inside advance().
+ *
+ * Usage:
+ *   uart_protocol::TimerWheel wheel(timing::get_tick_ms());
+ *   uart_protocol::TimerNode retransmit;
+ *   wheel.schedule(retransmit, 200, on_retransmit, &link); // fires ~200 ticks from now
+ *   wheel.cancel(retransmit);                              // e.g. ACK received
+ *   wheel.advance(timing::get_tick_ms());                  // from the main loop
+ */
+
+namespace uart_protocol
+{
+    struct TimerNode;
+
+    // Timer callback. The node is disarmed before the call, so it may be scheduled again from inside.
+    using TimerCallback = void (*)(TimerNode &node, void *context);
+
+    struct TimerNode
+    {
+        TimerNode *next = nullptr;
+        TimerNode **pprev = nullptr; // Address of the pointer that points to this node (nullptr when idle)
+        uint32_t expires = 0;        // Absolute expiry tick
+        TimerCallback callback = nullptr;
+        void *context = nullptr;
+
+        TimerNode() = default;
+        TimerNode(const TimerNode &) = delete; // Linked in place, copying an armed node would corrupt the wheel
+        TimerNode &operator=(const TimerNode &) = delete;
+
+        bool armed() const { return pprev != nullptr; }
+    };
+
+    class TimerWheel
+    {
+    private:
+        static constexpr size_t LEVEL_BITS = config::TIMER_WHEEL_LEVEL_BITS;
+        static constexpr size_t LEVELS = config::TIMER_WHEEL_LEVELS;
+        static constexpr size_t SLOTS = size_t{1} << LEVEL_BITS;
+        static constexpr uint32_t SLOT_MASK = static_cast<uint32_t>(SLOTS - 1);
+
+        static_assert(LEVEL_BITS > 0 && LEVELS > 0 && LEVEL_BITS * LEVELS < 32, "Timer wheel must cover less than 2^32 ticks");
+
+        TimerNode *slots_[LEVELS][SLOTS] = {};
+        uint32_t current_;  // Last processed tick
+        size_t armed_ = 0;  // Timers currently linked
+
+        static void link(TimerNode *&head, TimerNode &node)
+        {
+            node.next = head;
+            if (head != nullptr)
+            {
+                head->pprev = &node.next;
+            }
+            head = &node;
+            node.pprev = &head;
+        }
+
+        static void unlink(TimerNode &node)
+        {
+            *node.pprev = node.next;
+            if (node.next != nullptr)
+            {
+                node.next->pprev = node.pprev;
+            }
+            node.next = nullptr;
+            node.pprev = nullptr;
+        }
+
+        // Place a node relative to current_. A node that is already due goes into the slot being processed.
+        void insert(TimerNode &node)
+        {
+            uint32_t expires = node.expires;
+            if (static_cast<int32_t>(expires - current_) <= 0)
+            {
+                link(slots_[0][current_ & SLOT_MASK], node);
+                return;
+            }
+
+            // Lowest level whose higher-order bits match the current tick: the node's slot index on
+            // that level is then strictly ahead of the current index, so it cascades exactly in time.
+            for (size_t level = 0; level < LEVELS - 1; ++level)
+            {
+                size_t shift = LEVEL_BITS * (level + 1);
+                if ((expires >> shift) == (current_ >> shift))
+                {
+                    link(slots_[level][(expires >> (LEVEL_BITS * level)) & SLOT_MASK], node);
+                    return;
+                }
+            }
+
+            constexpr size_t top_shift = LEVEL_BITS * (LEVELS - 1);
+            uint32_t top_index = (current_ >> top_shift) & SLOT_MASK;
+            if ((expires >> (top_shift + LEVEL_BITS)) == (current_ >> (top_shift + LEVEL_BITS)))
+            {
+                top_index = (expires >> top_shift) & SLOT_MASK;
+            }
+            else
+            {
+                // Beyond the wheel: park in the next top-level slot, re-evaluated when it cascades
+                top_index = (top_index + 1) & SLOT_MASK;
+            }
+            link(slots_[LEVELS - 1][top_index], node);
+        }
+
+        // Re-insert every node of a higher-level slot into the levels below
+        void cascade(size_t level, uint32_t index)
+        {
+            TimerNode *node = slots_[level][index];
+            slots_[level][index] = nullptr;
+            while (node != nullptr)
+            {
+                TimerNode *next = node->next;
+                node->next = nullptr;
+                node->pprev = nullptr;
+                insert(*node);
+                node = next;
+            }
+        }
+
+        // Advance by one tick, fire the timers due on it. Returns the number of fired timers.
+        size_t tick()
+        {
+            ++current_;
+
+            // Cascade from the highest level whose index just changed down to level 1
+            size_t top = 0;
+            while (top < LEVELS - 1 && ((current_ >> (LEVEL_BITS * top)) & SLOT_MASK) == 0)
+            {
+                ++top;
+            }
+            for (size_t level = top; level >= 1; --level)
+            {
+                cascade(level, (current_ >> (LEVEL_BITS * level)) & SLOT_MASK);
+            }
+
+            // Detach the due slot first: callbacks may cancel other due timers or re-schedule themselves
+            TimerNode *due = slots_[0][current_ & SLOT_MASK];
+            if (due == nullptr)
+            {
+                return 0;
+            }
+            TimerNode *pending = due;
+            pending->pprev = &pending;
+            slots_[0][current_ & SLOT_MASK] = nullptr;
+
+            size_t fired = 0;
+            while (pending != nullptr)
+            {
+                TimerNode &node = *pending;
+                unlink(node);
+                --armed_;
+                ++fired;
+                if (node.callback != nullptr)
+                {
+                    node.callback(node, node.context);
+                }
+            }
+            return fired;
+        }
+
+    public:
+        // Start the wheel at the given tick (e.g. timing::get_tick_ms())
+        explicit TimerWheel(uint32_t now = 0) : current_(now) {}
+
+        TimerWheel(const TimerWheel &) = delete;
+        TimerWheel &operator=(const TimerWheel &) = delete;
+
+        /*
+         * Arm (or re-arm) a timer.
+         * @param node Timer to arm. Re-arming an armed timer moves its deadline.
+         * @param delay Ticks from the current wheel time, 0 is treated as 1 (fires on the next tick).
+         * @param callback Called from advance() when the timer fires.
+         * @param context User pointer passed to the callback.
+         */
+        void schedule(TimerNode &node, uint32_t delay, TimerCallback callback, void *context)
+        {
+            if (node.armed())
+            {
+                unlink(node);
+                --armed_;
+            }
+            node.expires = current_ + (delay == 0 ? 1 : delay);
+            node.callback = callback;
+            node.context = context;
+            insert(node);
+            ++armed_;
+        }
+
+        // Disarm a timer. Returns false if it was not armed.
+        bool cancel(TimerNode &node)
+        {
+            if (!node.armed())
+            {
+                return false;
+            }
+            unlink(node);
+            --armed_;
+            return true;
+        }
+
+        /*
+         * Process every tick up to `now` and fire the timers that expired.
+         * @param now Current time in wheel ticks (same unit and clock as the constructor argument).
+         * @return Number of fired timers.
+         */
+        size_t advance(uint32_t now)
+        {
+            if (armed_ == 0)
+            {
+                current_ = now; // Nothing to fire or cascade, jump straight there
+                return 0;
+            }
+
+            size_t fired = 0;
+            while (static_cast<int32_t>(now - current_) > 0)
+            {
+                fired += tick();
+                if (armed_ == 0)
+                {
+                    current_ = now;
+                    break;
+                }
+            }
+            return fired;
+        }
+
+        // Ticks until the timer fires (0 if due or not armed)
+        uint32_t remaining(const TimerNode &node) const
+        {
+            if (!node.armed() || static_cast<int32_t>(node.expires - current_) <= 0)
+            {
+                return 0;
+            }
+            return node.expires - current_;
+        }
+
+        uint32_t now() const { return current_; }
+        size_t armed() const { return armed_; }
+    };
+} // namespace uart_protocol
@@ -26,12 +26,18 @@
  * Supported Platforms:
  * - USE_FREERTOS: FreeRTOS-based systems (define this before including)
  * - USE_STD_CHRONO: Standard C++ with <chrono> (default for PC/desktop)
- * - BARE_METAL: Custom implementations (user must provide get_tick_ms and delay_ms)
+ * - BARE_METAL: Custom implementations (user must provide get_tick_ms, delay_ms, get_tick_us64 and delay_us)
  *
  * Usage:
  * - timing::get_tick_ms() -> Returns current time in milliseconds
  * - timing::delay_ms(ms) -> Delays for specified milliseconds
  * - timing::has_elapsed(start, duration) -> Checks if duration has passed since start
+ *
+ * Microsecond clock (a 16-byte frame at 3 Mbaud is ~53 us on the wire):
+ * - timing::get_tick_us64() -> Monotonic 64-bit time in microseconds (never wraps in practice)
+ * - timing::get_tick_us() -> Same clock truncated to 32 bits (wraps every ~71 minutes)
+ * - timing::delay_us(us) -> Sub-millisecond delay
+ * - timing::has_elapsed_us(start, duration) / get_elapsed_us(start) -> Wraparound-safe 32-bit helpers
  */
 
 namespace uart_protocol::timing
@@ -42,14 +48,61 @@ namespace uart_protocol::timing
 
 #if defined(USE_FREERTOS)
     /* FreeRTOS Implementation */
+    // portTICK_PERIOD_MS is an integer and truncates to 0 above 1 kHz: tick conversions use configTICK_RATE_HZ
+    static_assert(configTICK_RATE_HZ > 0 && configTICK_RATE_HZ <= 1000000, "configTICK_RATE_HZ must be between 1 Hz and 1 MHz");
+
+    inline uint64_t get_tick_us64();
+
+    // Derived from the 64-bit clock, so it wraps at 2^32 ms like the other ports (not when TickType_t wraps)
     inline uint32_t get_tick_ms()
     {
-        return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+        return static_cast<uint32_t>(get_tick_us64() / 1000u);
     }
 
     inline void delay_ms(uint32_t ms)
     {
-        vTaskDelay(pdMS_TO_TICKS(ms));
+        // A non-zero delay blocks for at least one tick (pdMS_TO_TICKS rounds 1 ms down to 0 below 1 kHz)
+        TickType_t ticks = pdMS_TO_TICKS(ms);
+        vTaskDelay(ticks == 0 && ms > 0 ? 1 : ticks);
+    }
+
+#if defined(configTIMING_GET_TICK_US64)
+    /* Port-provided microsecond timer (e.g. esp_timer_get_time() on ESP-IDF) */
+    inline uint64_t get_tick_us64()
+    {
+        return static_cast<uint64_t>(configTIMING_GET_TICK_US64());
+    }
+#else
+    /* Tick-based fallback: microsecond unit, tick resolution.
+     * vTaskSetTimeOutState() snapshots the tick count together with its overflow counter in one critical
+     * section, which extends a 16/32-bit TickType_t to 64 bits across its wrap without extra state. */
+    inline uint64_t get_tick_us64()
+    {
+        TimeOut_t now;
+        vTaskSetTimeOutState(&now);
+        uint64_t ticks = static_cast<uint64_t>(now.xTimeOnEntering);
+        if constexpr (sizeof(TickType_t) < 8)
+        {
+            // A 64-bit TickType_t never overflows, and shifting by its width would be undefined
+            ticks |= static_cast<uint64_t>(static_cast<UBaseType_t>(now.xOverflowCount)) << (sizeof(TickType_t) * 8);
+        }
+        return ticks * 1000000u / configTICK_RATE_HZ;
+    }
+#endif
+
+    inline void delay_us(uint32_t us)
+    {
+        // Whole ticks are slept, the remainder is yielded away until the clock reaches the deadline
+        uint64_t deadline = get_tick_us64() + us;
+        constexpr uint32_t tick_us = 1000000u / configTICK_RATE_HZ;
+        if (us >= tick_us)
+        {
+            vTaskDelay(static_cast<TickType_t>(us / tick_us));
+        }
+        while (get_tick_us64() < deadline)
+        {
+            taskYIELD();
+        }
     }
 
 #elif defined(USE_STD_CHRONO) || !defined(BARE_METAL)
@@ -66,6 +119,28 @@ namespace uart_protocol::timing
         std::this_thread::sleep_for(std::chrono::milliseconds(ms));
     }
 
+    inline uint64_t get_tick_us64()
+    {
+        using namespace std::chrono;
+        return static_cast<uint64_t>(
+            duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    inline void delay_us(uint32_t us)
+    {
+        // OS sleeps overshoot by tens of microseconds: sleep the bulk, spin the last part
+        constexpr uint32_t spin_us = 200;
+        uint64_t deadline = get_tick_us64() + us;
+        if (us > spin_us)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(us - spin_us));
+        }
+        while (get_tick_us64() < deadline)
+        {
+            std::this_thread::yield();
+        }
+    }
+
 #elif defined(BARE_METAL)
     /* Bare-Metal Implementation (Custom) */
     /*
@@ -80,11 +155,22 @@ namespace uart_protocol::timing
      *     // Implement delay in milliseconds
      *     // Example: HAL_Delay(ms); for STM32
      * }
+     *
+     * uint64_t uart_protocol::timing::get_tick_us64() {
+     *     // Return a monotonic microsecond counter
+     *     // Example: DWT->CYCCNT or a free-running 32-bit timer extended in its overflow IRQ
+     * }
+     *
+     * void uart_protocol::timing::delay_us(uint32_t us) {
+     *     // Implement delay in microseconds (busy-wait on get_tick_us64() is fine)
+     * }
      */
 
     // Forward declarations - must be implemented by user
     uint32_t get_tick_ms();
     void delay_ms(uint32_t ms);
+    uint64_t get_tick_us64();
+    void delay_us(uint32_t us);
 
 #else
 #error "No timing platform defined. Define USE_FREERTOS, USE_STD_CHRONO, or BARE_METAL"
@@ -118,4 +204,41 @@ namespace uart_protocol::timing
         return get_tick_ms() - start_ms; // Handles overflow automatically
     }
 
+    /*
+     * Get current time in microseconds, truncated to 32 bits.
+     * Wraps every ~71 minutes, use with has_elapsed_us/get_elapsed_us (or get_tick_us64 for absolute time).
+     *
+     * @return Current time in microseconds
+     */
+    inline uint32_t get_tick_us()
+    {
+        return static_cast<uint32_t>(get_tick_us64());
+    }
+
+    /*
+     * Check if a specified duration has elapsed since a start time.
+     * Handles uint32_t overflow correctly.
+     *
+     * @param start_us Start time in microseconds (from get_tick_us)
+     * @param duration_us Duration to check in microseconds
+     * @return true if duration has elapsed, false otherwise
+     */
+    inline bool has_elapsed_us(uint32_t start_us, uint32_t duration_us)
+    {
+        uint32_t elapsed = get_tick_us() - start_us; // Handles overflow automatically
+        return elapsed >= duration_us;
+    }
+
+    /*
+     * Get elapsed time since a start time.
+     * Handles uint32_t overflow correctly.
+     *
+     * @param start_us Start time in microseconds (from get_tick_us)
+     * @return Elapsed time in microseconds
+     */
+    inline uint32_t get_elapsed_us(uint32_t start_us)
+    {
+        return get_tick_us() - start_us; // Handles overflow automatically
+    }
+
 } // namespace uart_protocol::timing
@@ -0,0 +1,335 @@
+#pragma once
+#include "ProtocolConfig.hpp"
+#include "frame_utility.hpp"
+#include "protocol.hpp"
+#include "timing_utility.hpp"
+#include "timer_wheel.hpp"
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * Transaction - Correlated CMD/RESP exchanges with several commands in flight.
+ *
+ * The first payload byte of CMD_TYPE and RESP_TYPE frames carries a transaction ID:
+ *   CMD  payload: [ID (1 byte)] + [command bytes]
+ *   RESP payload: [ID (1 byte)] + [response bytes]   (ID copied from the command)
+ *
+ * TransactionTable keeps a fixed-size table of pending requests, each with its own deadline and
+ * completion callback. CommandClient ties the table to a protocol:
+ *  - send_command() tags and sends a CMD frame, returns its ID (0 if the table is full)
+ *  - on_frame() completes the matching request when its RESP frame arrives
+ *  - poll() times out requests whose deadline passed
+ *
+ * Deadlines: by default poll()/expire() scan the table. When a TimerWheel ticking in milliseconds is
+ * passed to the constructor, each request arms a timer instead and times out from wheel.advance(), so
+ * many tables (links) can share one wheel without scanning.
+ *
+ * Callbacks run in the context that calls on_frame()/poll()/cancel(). The response payload pointer is
+ * only valid during the callback. A callback may fulfil a std::promise if a future is preferred.
+ *
+ * Device side: reply with send_response(protocol, transaction_id_of(cmd_frame), data, len).
+ */
+
+namespace uart_protocol
+{
+    enum class TransactionStatus : uint8_t
+    {
+        Completed, // Matching RESP frame received
+        TimedOut,  // Deadline passed without a response
+        Cancelled  // Cancelled by the application
+    };
+
+    // Completion callback: payload/len is the response data after the ID byte (nullptr/0 unless Completed).
+    using TransactionCallback = void (*)(void *context, uint8_t id, TransactionStatus status, const uint8_t *payload, size_t len);
+
+    // Transaction ID of a CMD/RESP frame, 0 if the frame carries none (0 is never assigned).
+    inline uint8_t transaction_id_of(const FrameView &frame)
+    {
+        return frame.payload_size == 0 ? 0 : frame.payload[0];
+    }
+
+    inline uint8_t transaction_id_of(const Frame &frame)
+    {
+        return transaction_id_of(FrameView{frame.type, frame.payload.data(), frame.payload.size()});
+    }
+
+    template <size_t MaxPending = config::MAX_PENDING_TRANSACTIONS>
+    class TransactionTable
+    {
+        static_assert(MaxPending > 0 && MaxPending < 255, "MaxPending must be in [1, 254] (IDs are 1 byte, 0 is reserved)");
+
+    private:
+        struct Entry
+        {
+            bool active = false;
+            uint8_t id = 0;
+            uint32_t start_ms = 0;
+            uint32_t timeout_ms = 0;
+            TransactionCallback callback = nullptr;
+            void *context = nullptr;
+            TimerNode timer; // Armed only when a wheel is used
+        };
+
+        Entry entries_[MaxPending];
+        size_t pending_ = 0;
+        uint8_t next_id_ = 1;
+        TimerWheel *wheel_ = nullptr;
+
+        Entry *find(uint8_t id)
+        {
+            for (auto &entry : entries_)
+            {
+                if (entry.active && entry.id == id)
+                {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+
+        // Next free ID in 1..255, skipping IDs still in flight
+        uint8_t allocate_id()
+        {
+            for (;;)
+            {
+                uint8_t id = next_id_;
+                next_id_ = static_cast<uint8_t>(next_id_ == 255 ? 1 : next_id_ + 1);
+                if (find(id) == nullptr)
+                {
+                    return id;
+                }
+            }
+        }
+
+        void finish(Entry &entry, TransactionStatus status, const uint8_t *payload, size_t len)
+        {
+            if (wheel_ != nullptr)
+            {
+                wheel_->cancel(entry.timer);
+            }
+            entry.active = false;
+            if (entry.callback != nullptr)
+            {
+                entry.callback(entry.context, entry.id, status, payload, len);
+            }
+        }
+
+        static void on_timeout(TimerNode &node, void *context)
+        {
+            auto *table = static_cast<TransactionTable *>(context);
+            for (auto &entry : table->entries_)
+            {
+                if (entry.active && &entry.timer == &node)
+                {
+                    --table->pending_;
+                    table->finish(entry, TransactionStatus::TimedOut, nullptr, 0);
+                    return;
+                }
+            }
+        }
+
+    public:
+        // Without a wheel deadlines are checked by expire(). With a wheel (ticking in ms) they fire from wheel->advance().
+        explicit TransactionTable(TimerWheel *wheel = nullptr) : wheel_(wheel) {}
+
+        TransactionTable(const TransactionTable &) = delete;
+        TransactionTable &operator=(const TransactionTable &) = delete;
+
+        /*
+         * Reserve a table entry for a new request.
+         * @param timeout_ms Time allowed for the response, measured from now.
+         * @param callback Completion callback (may be nullptr).
+         * @param context User pointer passed to the callback.
+         * @return Transaction ID (1..255), or 0 if MaxPending requests are already in flight.
+         */
+        uint8_t begin(uint32_t timeout_ms, TransactionCallback callback, void *context)
+        {
+            if (pending_ == MaxPending)
+            {
+                return 0;
+            }
+            for (auto &entry : entries_)
+            {
+                if (!entry.active)
+                {
+                    entry.active = true;
+                    entry.id = allocate_id();
+                    entry.start_ms = timing::get_tick_ms();
+                    entry.timeout_ms = timeout_ms;
+                    entry.callback = callback;
+                    entry.context = context;
+                    if (wheel_ != nullptr)
+                    {
+                        wheel_->schedule(entry.timer, timeout_ms, &TransactionTable::on_timeout, this);
+                    }
+                    ++pending_;
+                    return entry.id;
+                }
+            }
+            return 0;
+        }
+
+        // Complete the request with this ID. Returns false if no such request is pending (late or unknown response).
+        bool complete(uint8_t id, const uint8_t *payload, size_t len)
+        {
+            Entry *entry = find(id);
+            if (entry == nullptr)
+            {
+                return false;
+            }
+            --pending_;
+            finish(*entry, TransactionStatus::Completed, payload, len);
+            return true;
+        }
+
+        // Cancel a pending request. The callback runs with TransactionStatus::Cancelled.
+        bool cancel(uint8_t id)
+        {
+            Entry *entry = find(id);
+            if (entry == nullptr)
+            {
+                return false;
+            }
+            --pending_;
+            finish(*entry, TransactionStatus::Cancelled, nullptr, 0);
+            return true;
+        }
+
+        // Drop a pending request without invoking its callback
+        bool release(uint8_t id)
+        {
+            Entry *entry = find(id);
+            if (entry == nullptr)
+            {
+                return false;
+            }
+            if (wheel_ != nullptr)
+            {
+                wheel_->cancel(entry->timer);
+            }
+            entry->active = false;
+            --pending_;
+            return true;
+        }
+
+        // Time out every request whose deadline passed. Returns the number of expired requests.
+        // With a wheel this is a no-op, the wheel fires the deadlines.
+        size_t expire()
+        {
+            if (wheel_ != nullptr)
+            {
+                return 0;
+            }
+            size_t expired = 0;
+            for (auto &entry : entries_)
+            {
+                if (entry.active && timing::has_elapsed(entry.start_ms, entry.timeout_ms))
+                {
+                    --pending_;
+                    finish(entry, TransactionStatus::TimedOut, nullptr, 0);
+                    ++expired;
+                }
+            }
+            return expired;
+        }
+
+        size_t pending() const { return pending_; }
+        bool full() const { return pending_ == MaxPending; }
+    };
+
+    // Send a RESP frame answering the command with the given transaction ID
+    template <typename UartT>
+    inline bool send_response(BasicProtocol<UartT> &protocol, uint8_t id, const uint8_t *payload, size_t len)
+    {
+        if (len + 1 > config::MAX_PAYLOAD_SIZE)
+        {
+            return false;
+        }
+        uint8_t buffer[config::MAX_PAYLOAD_SIZE];
+        buffer[0] = id;
+        for (size_t i = 0; i < len; ++i)
+        {
+            buffer[i + 1] = payload[i];
+        }
+        return protocol.send_frame(config::RESP_TYPE, buffer, len + 1);
+    }
+
+    template <typename UartT, size_t MaxPending = config::MAX_PENDING_TRANSACTIONS>
+    class CommandClient
+    {
+    private:
+        BasicProtocol<UartT> &protocol_;
+        TransactionTable<MaxPending> table_;
+
+    public:
+        // Pass a wheel ticking in milliseconds to drive the response deadlines from it instead of poll()
+        explicit CommandClient(BasicProtocol<UartT> &protocol, TimerWheel *wheel = nullptr) : protocol_(protocol), table_(wheel) {}
+
+        /*
+         * Send a CMD frame tagged with a new transaction ID.
+         * @param command Command bytes (at most config::MAX_PAYLOAD_SIZE - 1).
+         * @param len Number of command bytes.
+         * @param callback Completion callback (Completed, TimedOut or Cancelled).
+         * @param context User pointer passed to the callback.
+         * @param timeout_ms Response deadline measured from now.
+         * @return Transaction ID, or 0 if the table is full, the command too long or the send failed.
+         */
+        uint8_t send_command(const uint8_t *command, size_t len, TransactionCallback callback, void *context,
+                             uint32_t timeout_ms = config::DEFAULT_RESPONSE_TIMEOUT_MS)
+        {
+            if (len + 1 > config::MAX_PAYLOAD_SIZE)
+            {
+                return 0;
+            }
+
+            uint8_t id = table_.begin(timeout_ms, callback, context);
+            if (id == 0)
+            {
+                return 0;
+            }
+
+            uint8_t buffer[config::MAX_PAYLOAD_SIZE];
+            buffer[0] = id;
+            for (size_t i = 0; i < len; ++i)
+            {
+                buffer[i + 1] = command[i];
+            }
+
+            if (!protocol_.send_frame(config::CMD_TYPE, buffer, len + 1))
+            {
+                // Never reached the driver: release the entry without invoking the callback
+                table_.release(id);
+                return 0;
+            }
+            return id;
+        }
+
+        // Feed a received frame (e.g. from receive_frames()). Returns true if it was a RESP frame matching a pending command.
+        bool on_frame(const FrameView &frame)
+        {
+            if (frame.type != config::RESP_TYPE || frame.payload_size == 0)
+            {
+                return false;
+            }
+            return table_.complete(frame.payload[0], frame.payload + 1, frame.payload_size - 1);
+        }
+
+        bool on_frame(const Frame &frame)
+        {
+            return on_frame(FrameView{frame.type, frame.payload.data(), frame.payload.size()});
+        }
+
+        // Time out overdue commands. Call periodically from the RX/TX loop (not needed when a wheel is used).
+        size_t poll()
+        {
+            return table_.expire();
+        }
+
+        bool cancel(uint8_t id)
+        {
+            return table_.cancel(id);
+        }
+
+        size_t pending() const { return table_.pending(); }
+    };
+} // namespace uart_protocol
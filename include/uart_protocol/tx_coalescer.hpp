@@ -0,0 +1,199 @@
+#pragma once
+#include "peripheral.hpp"
+#include "ProtocolConfig.hpp"
+#include "timing_utility.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/*
+ * TX Coalescer - Opt-in stage that merges small writes into single driver writes.
+ *
+ * CoalescingUart wraps a driver and is itself a Uart, so it can be placed under a Protocol,
+ * a TxScheduler drain or any other writer without changing them. Each send_data() call is appended
+ * to a staging buffer; the staged bytes are handed to the wrapped driver in one send_data() call when:
+ *  - the staged size reaches the flush threshold, or
+ *  - the oldest staged byte is older than the max delay (checked by send_data() and poll()), or
+ *  - receive_data() is called (the peer cannot answer what was never sent), or
+ *  - flush() is called explicitly.
+ *
+ * On USB-CDC and tty backends every driver write is a syscall and usually its own USB transfer,
+ * so bursts of small ACK/keep-alive frames become one transfer.
+ *
+ * Frames are never split between two driver writes unless a single write is larger than the staging
+ * buffer, in which case it is passed through directly (after flushing what is staged).
+ *
+ * Note: Not internally synchronized. The deadline is only enforced when send_data() or poll()
+ * runs, so call poll() from the TX loop.
+ *
+ * Usage:
+ *   uart_protocol::CoalescingUart<MyUart> tx_stage(my_uart);
+ *   uart_protocol::BasicProtocol<decltype(tx_stage)> protocol(tx_stage);
+ *   protocol.send_ack();          // staged
+ *   tx_stage.poll();              // flushes once the deadline passed
+ *   tx_stage.flush();             // or immediately
+ */
+
+namespace uart_protocol
+{
+    template <typename UartT, size_t Capacity = config::TX_COALESCE_BUFFER_SIZE>
+    class CoalescingUart final : public Uart
+    {
+        static_assert(is_uart_transport<UartT>::value, "UartT must provide init(), deinit(), send_data() and receive_data()");
+        static_assert(Capacity > 0, "Staging buffer capacity must be greater than zero");
+
+    private:
+        UartT &uart_;
+        uint8_t staging_[Capacity];
+        size_t staged_ = 0;
+        size_t flush_threshold_ = Capacity;
+        uint32_t max_delay_us_ = config::TX_COALESCE_MAX_DELAY_US;
+        uint32_t oldest_us_ = 0; // time the first currently staged byte was written
+
+        uint32_t writes_requested_ = 0; // send_data() calls accepted
+        uint32_t writes_issued_ = 0;    // Successful send_data() calls on the wrapped driver
+        uint32_t write_failures_ = 0;   // send_data() calls the wrapped driver refused
+
+        bool write_through(const uint8_t *data, size_t size)
+        {
+            if (!uart_send_data(uart_, data, size))
+            {
+                ++write_failures_;
+                return false;
+            }
+            ++writes_issued_;
+            return true;
+        }
+
+    public:
+        explicit CoalescingUart(UartT &uart) : uart_(uart) {}
+
+        bool init() override
+        {
+            return uart_.init();
+        }
+
+        // Flushes staged bytes before tearing down the driver
+        void deinit() override
+        {
+            flush();
+            uart_.deinit();
+        }
+
+        /*
+         * Stage bytes for a later combined write.
+         * Returns true once the bytes are staged: they go out with a later flush even if the flush triggered
+         * here is refused by the driver (counted in write_failures(), retried by the next flush()/poll()).
+         * Returns false only if the bytes were not taken (no room and the staged bytes could not be flushed),
+         * so a caller that retries never puts the same frame on the wire twice.
+         */
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            if (size == 0)
+            {
+                return true;
+            }
+
+            // Does not fit even in an empty buffer: keep ordering and write it directly
+            if (size > Capacity)
+            {
+                if (!flush())
+                {
+                    return false;
+                }
+                ++writes_requested_;
+                return write_through(data, size);
+            }
+
+            if (staged_ + size > Capacity && !flush())
+            {
+                return false;
+            }
+
+            if (staged_ == 0)
+            {
+                oldest_us_ = timing::get_tick_us();
+            }
+            std::memcpy(staging_ + staged_, data, size);
+            staged_ += size;
+            ++writes_requested_;
+
+            if (staged_ >= flush_threshold_)
+            {
+                flush();
+            }
+            else
+            {
+                poll();
+            }
+            return true;
+        }
+
+        // Receive path is not buffered, forwarded to the wrapped driver. Staged bytes are flushed first:
+        // a reader may be waiting for the answer to them (e.g. BasicProtocol::send_frame_wait_ack).
+        size_t receive_data(uint8_t *out_buffer, size_t max_bytes) override
+        {
+            flush();
+            return uart_receive_data(uart_, out_buffer, max_bytes);
+        }
+
+        // Write all staged bytes in one driver call. Returns false if the driver refused them (they stay staged).
+        bool flush()
+        {
+            if (staged_ == 0)
+            {
+                return true;
+            }
+            if (!write_through(staging_, staged_))
+            {
+                return false;
+            }
+            staged_ = 0;
+            return true;
+        }
+
+        // Flush if the oldest staged byte has waited for the max delay. Call periodically from the TX loop.
+        bool poll()
+        {
+            if (staged_ > 0 && static_cast<uint32_t>(timing::get_tick_us() - oldest_us_) >= max_delay_us_)
+            {
+                return flush();
+            }
+            return true;
+        }
+
+        // Flush as soon as `bytes` are staged (clamped to [1, Capacity])
+        void set_flush_threshold(size_t bytes)
+        {
+            flush_threshold_ = bytes == 0 ? 1 : (bytes > Capacity ? Capacity : bytes);
+        }
+
+        // Max time a staged byte may wait before poll()/send_data() flushes it. 0 disables the delay (flush on poll).
+        void set_max_delay_us(uint32_t delay_us)
+        {
+            max_delay_us_ = delay_us;
+        }
+
+        size_t staged_bytes() const { return staged_; }
+
+        // Write statistics
+        uint32_t writes_requested() const { return writes_requested_; }
+        uint32_t writes_issued() const { return writes_issued_; }
+        uint32_t write_failures() const { return write_failures_; }
+        // Requested writes that were merged into another driver write (failed driver writes count as attempts, not as saved)
+        uint32_t writes_saved() const
+        {
+            uint32_t attempts = writes_issued_ + write_failures_;
+            return writes_requested_ > attempts ? writes_requested_ - attempts : 0;
+        }
+
+        void reset_stats()
+        {
+            writes_requested_ = 0;
+            writes_issued_ = 0;
+            write_failures_ = 0;
+        }
+
+        UartT &uart() { return uart_; }
+    };
+} // namespace uart_protocol
@@ -0,0 +1,276 @@
+#pragma once
+#include "peripheral.hpp"
+#include "ProtocolConfig.hpp"
+#include "frame_utility.hpp"
+#include "mpsc_frame_queue.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <utility>
+
+/*
+ * TX Scheduler - Bounded, priority-aware outbound frame queue.
+ *
+ * Frames are encoded into fixed slots at enqueue time (no allocation) and sorted into three classes:
+ *  - Control: ACK, NACK, START_WORD, ARE_YOU_THERE, ERROR, CREDIT
+ *  - Command: CMD, RESP
+ *  - Data:    DATA and any other frame type
+ *
+ * drain() is the single place that writes to the Uart. It always sends the highest non-empty class
+ * first, so an ACK enqueued behind a long DATA burst waits for at most the frame currently on the wire.
+ *
+ * Backpressure: each class has its own depth. enqueue() returns TxStatus::QueueFull instead of
+ * blocking or dropping older frames, and free_slots()/rejected() let producers throttle themselves.
+ *
+ * Threading: each class is an MpscFrameQueue, so enqueue()/enqueue_encoded() may be called from any
+ * number of threads at once (e.g. the RX path queueing ACKs while the application queues DATA) without
+ * a lock. drain() and clear() must run in one consumer context. Class depths must be powers of two.
+ *
+ * Usage:
+ *   uart_protocol::TxScheduler<> tx;
+ *   tx.enqueue(config::DATA_TYPE, payload);   // from the application
+ *   tx.enqueue(config::ACK_TYPE, nullptr, 0); // jumps ahead of queued DATA frames (any thread)
+ *   tx.drain(uart);                           // from the TX loop
+ *
+ *   // Or under a protocol: every send_frame()/send_ack() is queued and drained by class
+ *   uart_protocol::ScheduledUart<MyUart> tx_stage(my_uart);
+ *   uart_protocol::BasicProtocol<decltype(tx_stage)> protocol(tx_stage);
+ *   protocol.send_frame(config::DATA_TYPE, payload);
+ *   protocol.send_ack();                      // drained before the DATA frame
+ *   tx_stage.drain();
+ */
+
+namespace uart_protocol
+{
+    enum class TxPriority : uint8_t
+    {
+        Control = 0,
+        Command = 1,
+        Data = 2
+    };
+
+    inline constexpr size_t TX_PRIORITY_COUNT = 3;
+
+    // Map a frame type to its scheduling class
+    inline constexpr TxPriority tx_priority_of(uint8_t type)
+    {
+        switch (type)
+        {
+        case config::ACK_TYPE:
+        case config::NACK_TYPE:
+        case config::START_WORD_TYPE:
+        case config::ARE_YOU_THERE_TYPE:
+        case config::ERROR_TYPE:
+        case config::CREDIT_TYPE:
+            return TxPriority::Control;
+        case config::CMD_TYPE:
+        case config::RESP_TYPE:
+            return TxPriority::Command;
+        default:
+            return TxPriority::Data;
+        }
+    }
+
+    template <size_t ControlDepth = config::TX_CONTROL_QUEUE_DEPTH,
+              size_t CommandDepth = config::TX_COMMAND_QUEUE_DEPTH,
+              size_t DataDepth = config::TX_DATA_QUEUE_DEPTH>
+    class TxScheduler
+    {
+    private:
+        MpscFrameQueue<ControlDepth> control_;
+        MpscFrameQueue<CommandDepth> command_;
+        MpscFrameQueue<DataDepth> data_;
+
+        static constexpr size_t depth_of(TxPriority priority)
+        {
+            return priority == TxPriority::Control ? ControlDepth : priority == TxPriority::Command ? CommandDepth
+                                                                                                    : DataDepth;
+        }
+
+        template <typename Fn>
+        decltype(auto) with_queue(TxPriority priority, Fn &&fn)
+        {
+            switch (priority)
+            {
+            case TxPriority::Control:
+                return fn(control_);
+            case TxPriority::Command:
+                return fn(command_);
+            default:
+                return fn(data_);
+            }
+        }
+
+        template <typename Fn>
+        decltype(auto) with_queue(TxPriority priority, Fn &&fn) const
+        {
+            return const_cast<TxScheduler *>(this)->with_queue(priority, std::forward<Fn>(fn));
+        }
+
+    public:
+        TxScheduler() = default;
+
+        // Non-copyable: slots are large and drained in place
+        TxScheduler(const TxScheduler &) = delete;
+        TxScheduler &operator=(const TxScheduler &) = delete;
+
+        /*
+         * Encode a frame into its priority class queue. Safe to call from several threads at once.
+         * @param type Frame type (selects the class, see tx_priority_of).
+         * @param payload Payload bytes (may be nullptr when payload_len is 0).
+         * @param payload_len Payload size, at most config::MAX_PAYLOAD_SIZE.
+         * @return TxStatus::Queued on success, QueueFull when the class is at its depth limit.
+         */
+        TxStatus enqueue(uint8_t type, const uint8_t *payload, size_t payload_len)
+        {
+            return with_queue(tx_priority_of(type), [&](auto &queue)
+                              { return queue.push_frame(type, payload, payload_len); });
+        }
+
+        TxStatus enqueue(uint8_t type, const std::vector<uint8_t> &payload)
+        {
+            return enqueue(type, payload.data(), payload.size());
+        }
+
+        /*
+         * Queue an already encoded frame, classed by its TYPE byte. Safe to call from several threads at once.
+         * Bytes that do not start with a frame header are queued as one Data-class unit.
+         * @param frame Encoded bytes, written to the driver unchanged in one send_data() call.
+         * @param size Number of bytes, at most MAX_FRAME_SIZE.
+         * @return TxStatus::Queued on success, QueueFull when the class is at its depth limit.
+         */
+        TxStatus enqueue_encoded(const uint8_t *frame, size_t size)
+        {
+            bool is_frame = size >= FRAME_OVERHEAD && size <= MAX_FRAME_SIZE &&
+                            (static_cast<uint16_t>(frame[0]) | (static_cast<uint16_t>(frame[1]) << 8)) == Frame::START_WORD;
+            uint8_t type = is_frame ? frame[3] : config::DATA_TYPE;
+            return with_queue(tx_priority_of(type), [&](auto &queue)
+                              { return queue.push_raw(frame, size); });
+        }
+
+        /*
+         * Write queued frames to the Uart, highest priority first. Consumer context only.
+         * Each frame is handed to the driver in a single send_data() call.
+         * @param uart Driver to write to.
+         * @param max_frames Upper bound on frames written by this call (bounds the time spent here).
+         * @return Number of frames written. Stops early if the driver refuses a frame; it stays queued.
+         */
+        template <typename UartT>
+        size_t drain(UartT &uart, size_t max_frames = SIZE_MAX)
+        {
+            size_t sent = 0;
+            while (sent < max_frames)
+            {
+                // Re-evaluate from the top every frame so newly queued control frames go next
+                size_t n;
+                if (control_.ready())
+                    n = control_.drain(uart, 1);
+                else if (command_.ready())
+                    n = command_.drain(uart, 1);
+                else if (data_.ready())
+                    n = data_.drain(uart, 1);
+                else
+                    break;
+
+                if (n == 0)
+                {
+                    break;
+                }
+                ++sent;
+            }
+            return sent;
+        }
+
+        // Frames waiting in a class queue (snapshot, callable from any thread)
+        size_t pending(TxPriority priority) const
+        {
+            return with_queue(priority, [](const auto &queue)
+                              { return queue.pending(); });
+        }
+
+        // Frames waiting in all queues (snapshot)
+        size_t pending() const
+        {
+            return control_.pending() + command_.pending() + data_.pending();
+        }
+
+        // Free slots in a class queue (0 means the next enqueue of that class is rejected)
+        size_t free_slots(TxPriority priority) const
+        {
+            size_t queued = pending(priority);
+            return queued < depth_of(priority) ? depth_of(priority) - queued : 0;
+        }
+
+        // Number of enqueue() calls rejected with QueueFull for a class
+        uint32_t rejected(TxPriority priority) const
+        {
+            return with_queue(priority, [](const auto &queue)
+                              { return static_cast<uint32_t>(queue.rejected()); });
+        }
+
+        bool empty() const { return pending() == 0; }
+
+        // Drop every queued frame (consumer context only)
+        void clear()
+        {
+            control_.discard();
+            command_.discard();
+            data_.discard();
+        }
+    };
+
+    /*
+     * ScheduledUart - Routes every write of the layer above through a TxScheduler.
+     * BasicProtocol<ScheduledUart<MyUart>> queues send_frame/send_ack/send_start_word by frame class,
+     * and drain() becomes the single place that writes to MyUart: an ACK queued behind DATA goes first.
+     * receive_data() drains before reading, so send_frame_wait_ack works without a separate TX loop.
+     * send_data() may be called from several threads (e.g. an RX task sending ACKs while the application
+     * sends DATA); drain() and receive_data() belong to one consumer context.
+     */
+    template <typename UartT,
+              size_t ControlDepth = config::TX_CONTROL_QUEUE_DEPTH,
+              size_t CommandDepth = config::TX_COMMAND_QUEUE_DEPTH,
+              size_t DataDepth = config::TX_DATA_QUEUE_DEPTH>
+    class ScheduledUart final : public Uart
+    {
+        static_assert(is_uart_transport<UartT>::value, "UartT must provide init(), deinit(), send_data() and receive_data()");
+
+    private:
+        UartT &uart_;
+        TxScheduler<ControlDepth, CommandDepth, DataDepth> scheduler_;
+
+    public:
+        explicit ScheduledUart(UartT &uart) : uart_(uart) {}
+
+        bool init() override { return uart_.init(); }
+
+        // Writes what is still queued before tearing down the driver
+        void deinit() override
+        {
+            drain();
+            uart_.deinit();
+        }
+
+        // Any thread: queue one encoded frame by its class. Returns false if that class is full (backpressure).
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            return scheduler_.enqueue_encoded(data, size) == TxStatus::Queued;
+        }
+
+        // Consumer context: drains queued frames first, a reader may be waiting for the answer to them
+        size_t receive_data(uint8_t *out_buffer, size_t max_bytes) override
+        {
+            drain();
+            return uart_receive_data(uart_, out_buffer, max_bytes);
+        }
+
+        // Consumer context: write queued frames, highest class first. Call from the TX loop.
+        size_t drain(size_t max_frames = SIZE_MAX)
+        {
+            return scheduler_.drain(uart_, max_frames);
+        }
+
+        TxScheduler<ControlDepth, CommandDepth, DataDepth> &scheduler() { return scheduler_; }
+        UartT &uart() { return uart_; }
+    };
+} // namespace uart_protocol
@@ -0,0 +1,167 @@
+#include "test_utility.hpp"
+#include "uart_protocol/capture.hpp"
+#include "uart_protocol/replay.hpp"
+#include "uart_protocol/parallel_decoder.hpp"
+#include "uart_protocol/protocol.hpp"
+
+using namespace uart_protocol;
+using namespace uart_protocol::capture;
+using namespace uart_protocol::test;
+
+namespace
+{
+    // Record a short session: three frames sent, a burst of five frames received in 7-byte chunks
+    std::vector<uint8_t> record_session(std::vector<uint8_t> &rx_stream)
+    {
+        std::string path = temp_path("session.upcap");
+        CaptureWriter writer;
+        EXPECT_TRUE(writer.open(path.c_str()));
+
+        MockUart uart;
+        CaptureUart<MockUart> tap(uart, writer);
+        Protocol protocol(tap);
+        for (uint8_t i = 0; i < 3; ++i)
+        {
+            protocol.send_frame(config::CMD_TYPE, {i});
+        }
+        for (uint8_t i = 0; i < 5; ++i)
+        {
+            append(rx_stream, make_frame(config::DATA_TYPE, {i, i, i}));
+        }
+        uart.rx = rx_stream;
+        uart.chunk_size = 7;
+        FrameView frames[8];
+        EXPECT_EQ(protocol.receive_frames(frames, 8), 5u);
+        writer.close();
+
+        auto bytes = read_file(path);
+        std::remove(path.c_str());
+        return bytes;
+    }
+} // namespace
+
+TEST(Capture, RecordsBothDirectionsInOrder)
+{
+    std::vector<uint8_t> rx_stream;
+    auto file = record_session(rx_stream);
+    CaptureReader reader(file.data(), file.size());
+    ASSERT_TRUE(reader.valid());
+
+    Record record;
+    size_t tx_records = 0;
+    uint64_t last_timestamp = 0;
+    while (reader.next(record))
+    {
+        EXPECT_GE(record.timestamp_us, last_timestamp);
+        last_timestamp = record.timestamp_us;
+        if (record.direction == Direction::Tx)
+        {
+            EXPECT_EQ(std::vector<uint8_t>(record.data, record.data + record.size), make_frame(config::CMD_TYPE, {static_cast<uint8_t>(tx_records)}));
+            ++tx_records;
+        }
+        else
+        {
+            EXPECT_LE(record.size, 7u);
+        }
+    }
+    EXPECT_EQ(tx_records, 3u);
+    EXPECT_EQ(collect_stream(reader, Direction::Rx), rx_stream);
+}
+
+TEST(Capture, RefusedAndEmptyWritesAreNotRecorded)
+{
+    std::string path = temp_path("refused.upcap");
+    CaptureWriter writer;
+    ASSERT_TRUE(writer.open(path.c_str()));
+    MockUart uart;
+    CaptureUart<MockUart> tap(uart, writer);
+
+    auto frame = make_frame(config::DATA_TYPE, {1});
+    uart.refuse_writes = 1;
+    EXPECT_FALSE(tap.send_data(frame.data(), frame.size()));
+    EXPECT_TRUE(tap.send_data(frame.data(), 0));
+    EXPECT_TRUE(tap.send_data(frame.data(), frame.size()));
+    writer.close();
+
+    auto file = read_file(path);
+    std::remove(path.c_str());
+    CaptureReader reader(file.data(), file.size());
+    ASSERT_TRUE(reader.valid());
+    Record record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(std::vector<uint8_t>(record.data, record.data + record.size), frame);
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST(Capture, LargeChunksAreSplitIntoRecords)
+{
+    std::string path = temp_path("large.upcap");
+    CaptureWriter writer;
+    ASSERT_TRUE(writer.open(path.c_str()));
+    std::vector<uint8_t> chunk(MAX_RECORD_DATA + 100, 0x5A);
+    ASSERT_TRUE(writer.write(Direction::Rx, chunk.data(), chunk.size(), 42));
+    EXPECT_EQ(writer.records(), 2u);
+    writer.close();
+
+    auto file = read_file(path);
+    std::remove(path.c_str());
+    CaptureReader reader(file.data(), file.size());
+    EXPECT_EQ(collect_stream(reader, Direction::Rx), chunk);
+}
+
+TEST(Capture, ReaderRejectsForeignAndTruncatedFiles)
+{
+    const uint8_t garbage[32] = {'N', 'O', 'T', 'A', 'C', 'A', 'P'};
+    CaptureReader foreign(garbage, sizeof(garbage));
+    Record record;
+    EXPECT_FALSE(foreign.valid());
+    EXPECT_FALSE(foreign.next(record));
+
+    std::vector<uint8_t> rx_stream;
+    auto file = record_session(rx_stream);
+    file.resize(file.size() - 3); // Last record cut off
+    CaptureReader reader(file.data(), file.size());
+    size_t records = 0;
+    while (reader.next(record))
+    {
+        ++records;
+    }
+    EXPECT_GT(records, 0u);
+    EXPECT_LT(collect_stream(reader, Direction::Rx).size(), rx_stream.size());
+}
+
+TEST(Replay, DecodersAgreeOnTheCapturedStream)
+{
+    std::vector<uint8_t> rx_stream;
+    auto file = record_session(rx_stream);
+    CaptureReader reader(file.data(), file.size());
+
+    ReplayStats stream_stats = replay_decode(reader, Direction::Rx, StreamChunkDecoder{});
+    ReplayStats parse_stats = replay_decode(reader, Direction::Rx, ParseFrameDecoder{});
+    EXPECT_EQ(stream_stats.frames, 5u);
+    EXPECT_EQ(parse_stats.frames, 5u);
+    EXPECT_EQ(stream_stats.bytes, rx_stream.size());
+
+    auto stream = collect_stream(reader, Direction::Rx);
+    EXPECT_EQ(FrameIndex::build(stream.data(), stream.size(), 2).size(), 5u);
+}
+
+TEST(Replay, ReplayUartFeedsTheProtocol)
+{
+    std::vector<uint8_t> rx_stream;
+    auto file = record_session(rx_stream);
+    ReplayUart replay(CaptureReader(file.data(), file.size()), Direction::Rx, 1e6);
+    ASSERT_TRUE(replay.init());
+    BasicProtocol<ReplayUart> protocol(replay);
+
+    FrameView frames[8];
+    size_t received = 0;
+    for (int attempt = 0; attempt < 100 && received < 5; ++attempt)
+    {
+        received += protocol.receive_frames(frames + received, 8 - received);
+    }
+    EXPECT_EQ(received, 5u);
+    EXPECT_TRUE(replay.finished());
+    EXPECT_TRUE(protocol.send_ack());
+    EXPECT_EQ(replay.tx_bytes(), FRAME_OVERHEAD);
+}
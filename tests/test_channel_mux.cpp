@@ -0,0 +1,175 @@
+#include "test_utility.hpp"
+#include "uart_protocol/channel_mux.hpp"
+#include <thread>
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+
+namespace
+{
+    constexpr size_t CHANNELS = 2;
+    constexpr size_t WINDOW = 4;
+    using Mux = ChannelMux<MockUart, CHANNELS, WINDOW, 8>;
+
+    // One end of a link, its driver writes are delivered to the other end by pump()
+    struct End
+    {
+        MockUart uart;
+        BasicProtocol<MockUart> protocol{uart};
+        Mux mux{protocol};
+    };
+
+    // Deliver every frame `from` wrote to `to`. drop(type, index) returns true to lose a frame on the wire.
+    template <typename Drop>
+    size_t pump(End &from, End &to, Drop drop)
+    {
+        size_t delivered = 0;
+        for (size_t i = 0; i < from.uart.writes.size(); ++i)
+        {
+            const auto &write = from.uart.writes[i];
+            FrameView frame;
+            size_t consumed = 0;
+            if (decode_frame(write.data(), write.size(), frame, consumed) != ParseStatus::Ok || drop(frame.type, i))
+            {
+                continue;
+            }
+            to.mux.on_frame(frame);
+            ++delivered;
+        }
+        from.uart.writes.clear();
+        return delivered;
+    }
+
+    size_t pump(End &from, End &to)
+    {
+        return pump(from, to, [](uint8_t, size_t) { return false; });
+    }
+
+    TxStatus send_byte(End &end, uint8_t channel, uint8_t value)
+    {
+        return end.mux.send(channel, &value, 1);
+    }
+} // namespace
+
+TEST(ChannelMux, SenderStopsAtTheWindow)
+{
+    End a, b;
+    for (uint8_t i = 0; i < 6; ++i)
+    {
+        EXPECT_EQ(send_byte(a, 0, i), TxStatus::Queued);
+    }
+    a.mux.poll();
+    EXPECT_EQ(a.uart.writes.size(), WINDOW);
+    EXPECT_EQ(a.mux.credits(0), 0u);
+    EXPECT_EQ(a.mux.queued(0), 2u);
+
+    pump(a, b);
+    EXPECT_EQ(b.mux.available(0), WINDOW);
+}
+
+TEST(ChannelMux, ReleasedFramesGrantCredits)
+{
+    End a, b;
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        send_byte(a, 0, i);
+    }
+    a.mux.poll();
+    pump(a, b);
+
+    // Consuming half the window crosses the grant threshold
+    uint8_t out[MUX_MAX_DATA_SIZE];
+    ASSERT_EQ(b.mux.receive(0, out, sizeof(out)), 1u);
+    EXPECT_EQ(out[0], 0);
+    b.mux.receive(0, out, sizeof(out));
+    b.mux.poll();
+    ASSERT_EQ(b.uart.written_types(), (std::vector<uint8_t>{config::CREDIT_TYPE}));
+    pump(b, a);
+    EXPECT_EQ(a.mux.credits(0), 2u);
+
+    a.mux.poll();
+    pump(a, b);
+    EXPECT_EQ(b.mux.available(0), WINDOW);
+    std::vector<uint8_t> received;
+    while (b.mux.available(0) > 0)
+    {
+        b.mux.receive(0, out, sizeof(out));
+        received.push_back(out[0]);
+    }
+    EXPECT_EQ(received, (std::vector<uint8_t>{2, 3, 4, 5}));
+}
+
+TEST(ChannelMux, SlowChannelDoesNotBlockOthers)
+{
+    End a, b;
+    uint8_t value = 0;
+    while (send_byte(a, 0, value) == TxStatus::Queued) // Window sent, then the queue fills up
+    {
+        ++value;
+    }
+    EXPECT_EQ(value, WINDOW + 8);
+    EXPECT_EQ(a.mux.rejected(0), 1u);
+
+    EXPECT_EQ(send_byte(a, 1, 42), TxStatus::Queued);
+    a.mux.poll();
+    pump(a, b);
+    EXPECT_EQ(b.mux.available(0), WINDOW);
+    EXPECT_EQ(b.mux.available(1), 1u);
+}
+
+TEST(ChannelMux, FramesLostMidStreamReleaseTheirCredits)
+{
+    End a, b;
+    for (uint8_t i = 0; i < WINDOW; ++i)
+    {
+        send_byte(a, 0, i);
+    }
+    a.mux.poll();
+    pump(a, b, [](uint8_t, size_t index) { return index == 1; }); // Second frame corrupted on the wire
+
+    EXPECT_EQ(b.mux.lost(0), 1u);
+    EXPECT_EQ(b.mux.available(0), WINDOW - 1);
+
+    // The lost frame counts as released: with one frame consumed, half a window is granted again
+    uint8_t out[MUX_MAX_DATA_SIZE];
+    b.mux.receive(0, out, sizeof(out));
+    b.mux.poll();
+    pump(b, a);
+    EXPECT_EQ(a.mux.credits(0), 2u);
+}
+
+TEST(ChannelMux, LostTailFramesRecoverOnRefresh)
+{
+    End a, b;
+    for (uint8_t i = 0; i < WINDOW; ++i)
+    {
+        send_byte(a, 0, i);
+    }
+    a.mux.poll();
+    pump(a, b, [](uint8_t type, size_t) { return type == config::CHANNEL_DATA_TYPE; }); // Whole window lost
+    send_byte(a, 0, 99);
+    EXPECT_EQ(a.mux.credits(0), 0u);
+
+    // No later frame reveals the gap: only the periodic refresh with the expected sequence does
+    std::this_thread::sleep_for(std::chrono::milliseconds(config::MUX_CREDIT_REFRESH_MS + 50));
+    b.mux.poll();
+    pump(b, a);
+    EXPECT_EQ(a.mux.credits(0), WINDOW);
+
+    a.mux.poll();
+    pump(a, b);
+    uint8_t out[MUX_MAX_DATA_SIZE];
+    ASSERT_EQ(b.mux.receive(0, out, sizeof(out)), 1u);
+    EXPECT_EQ(out[0], 99);
+    EXPECT_EQ(b.mux.lost(0), WINDOW);
+}
+
+TEST(ChannelMux, StaleCreditNeverTakesBackCredit)
+{
+    End a;
+    const uint8_t newer[] = {0, static_cast<uint8_t>(WINDOW + 4), 0, 0};
+    const uint8_t older[] = {0, static_cast<uint8_t>(WINDOW), 0, 0};
+    a.mux.on_frame(config::CREDIT_TYPE, newer, sizeof(newer));
+    a.mux.on_frame(config::CREDIT_TYPE, older, sizeof(older));
+    EXPECT_EQ(a.mux.credits(0), WINDOW + 4);
+}
@@ -0,0 +1,153 @@
+#include "test_utility.hpp"
+#include "uart_protocol/fec.hpp"
+#include "uart_protocol/protocol.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+
+namespace
+{
+    constexpr size_t PARITY = 8;
+    using RS = ReedSolomon<PARITY>;
+    using Codec = FecCodec<PARITY, 32>;
+
+    // Corrupt `count` distinct bytes of a buffer (range [first, first + size))
+    void corrupt(std::vector<uint8_t> &bytes, size_t first, size_t size, size_t count, std::mt19937 &rng)
+    {
+        std::vector<size_t> positions(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            positions[i] = first + i;
+        }
+        std::shuffle(positions.begin(), positions.end(), rng);
+        for (size_t i = 0; i < count; ++i)
+        {
+            bytes[positions[i]] ^= static_cast<uint8_t>(1 + rng() % 255);
+        }
+    }
+} // namespace
+
+TEST(ReedSolomon, CleanCodewordNeedsNoCorrection)
+{
+    std::vector<uint8_t> codeword(40 + PARITY);
+    for (size_t i = 0; i < 40; ++i)
+    {
+        codeword[i] = static_cast<uint8_t>(i * 7);
+    }
+    RS::encode(codeword.data(), 40, codeword.data() + 40);
+    EXPECT_EQ(RS::decode(codeword.data(), codeword.size()), 0);
+}
+
+TEST(ReedSolomon, CorrectsUpToHalfTheParity)
+{
+    std::mt19937 rng(1234);
+    for (size_t errors = 1; errors <= PARITY / 2; ++errors)
+    {
+        for (int trial = 0; trial < 50; ++trial)
+        {
+            std::vector<uint8_t> original(60 + PARITY);
+            for (size_t i = 0; i < 60; ++i)
+            {
+                original[i] = static_cast<uint8_t>(rng());
+            }
+            RS::encode(original.data(), 60, original.data() + 60);
+
+            std::vector<uint8_t> received = original;
+            corrupt(received, 0, received.size(), errors, rng);
+            ASSERT_EQ(RS::decode(received.data(), received.size()), static_cast<int>(errors)) << errors << " errors";
+            ASSERT_EQ(received, original);
+        }
+    }
+}
+
+TEST(ReedSolomon, ReportsTooManyErrors)
+{
+    std::mt19937 rng(99);
+    size_t detected = 0;
+    constexpr int TRIALS = 200;
+    for (int trial = 0; trial < TRIALS; ++trial)
+    {
+        std::vector<uint8_t> codeword(30 + PARITY);
+        for (size_t i = 0; i < 30; ++i)
+        {
+            codeword[i] = static_cast<uint8_t>(rng());
+        }
+        RS::encode(codeword.data(), 30, codeword.data() + 30);
+        corrupt(codeword, 0, codeword.size(), PARITY / 2 + 1, rng);
+        if (RS::decode(codeword.data(), codeword.size()) < 0)
+        {
+            ++detected;
+        }
+    }
+    // Beyond t errors the decoder may miscorrect into another codeword (FecCodec's CRC catches those),
+    // but for a short code with 8 parity bytes it almost always reports the failure
+    EXPECT_GT(detected, TRIALS * 9 / 10);
+}
+
+TEST(FecCodec, RoundTripRepairsEveryBlock)
+{
+    std::mt19937 rng(7);
+    std::vector<uint8_t> payload(100);
+    for (auto &b : payload)
+    {
+        b = static_cast<uint8_t>(rng());
+    }
+    std::vector<uint8_t> encoded(Codec::encoded_size(payload.size()));
+    ASSERT_EQ(Codec::encode(config::DATA_TYPE, payload.data(), payload.size(), encoded.data()), encoded.size());
+
+    // Four bad bytes in each 40-byte block (32 data + 8 parity) after the 5-byte header
+    for (size_t block = 5; block < encoded.size(); block += 40)
+    {
+        size_t size = encoded.size() - block < 40 ? encoded.size() - block : 40;
+        corrupt(encoded, block, size, 4, rng);
+    }
+    encoded[2] ^= 0x40; // and one in LEN
+
+    uint8_t frame_out[MAX_FRAME_SIZE];
+    FrameView frame;
+    size_t consumed = 0, corrected = 0;
+    ASSERT_EQ(Codec::decode(encoded.data(), encoded.size(), frame_out, frame, consumed, corrected), ParseStatus::Ok);
+    EXPECT_EQ(consumed, encoded.size());
+    EXPECT_EQ(corrected, 4 * 4 + 1u);
+    EXPECT_EQ(frame.type, config::DATA_TYPE);
+    EXPECT_EQ(std::vector<uint8_t>(frame.payload, frame.payload + frame.payload_size), payload);
+}
+
+TEST(FecCodec, UncorrectableFrameIsRejected)
+{
+    std::vector<uint8_t> payload(20, 0x5A);
+    std::vector<uint8_t> encoded(Codec::encoded_size(payload.size()));
+    Codec::encode(config::DATA_TYPE, payload.data(), payload.size(), encoded.data());
+    for (size_t i = 5; i < 5 + PARITY; ++i)
+    {
+        encoded[i] ^= 0xFF;
+    }
+
+    uint8_t frame_out[MAX_FRAME_SIZE];
+    FrameView frame;
+    size_t consumed = 0, corrected = 0;
+    EXPECT_EQ(Codec::decode(encoded.data(), encoded.size(), frame_out, frame, consumed, corrected), ParseStatus::Invalid);
+    EXPECT_GT(consumed, 0u);
+}
+
+TEST(FecUart, ProtocolRunsOverTheFecLink)
+{
+    MockUart wire;
+    FecUart<MockUart, PARITY, 32> fec(wire);
+    BasicProtocol<FecUart<MockUart, PARITY, 32>> protocol(fec);
+
+    ASSERT_TRUE(protocol.send_frame(config::DATA_TYPE, {1, 2, 3}));
+    ASSERT_EQ(wire.writes.size(), 1u);
+    EXPECT_EQ(wire.writes[0].size(), Codec::encoded_size(3));
+
+    // Loop the FEC frame back with a corrupted payload byte
+    wire.rx = wire.writes[0];
+    wire.rx[7] ^= 0x81;
+    wire.chunk_size = 4;
+    FrameView frames[2];
+    ASSERT_EQ(protocol.receive_frames(frames, 2), 1u);
+    EXPECT_EQ(frames[0].payload[2], 3);
+    EXPECT_EQ(fec.corrected_frames(), 1u);
+}
@@ -0,0 +1,159 @@
+#include "test_utility.hpp"
+#include "uart_protocol/frame_trace.hpp"
+#include "uart_protocol/protocol.hpp"
+#include "uart_protocol/tx_scheduler.hpp"
+#include "uart_protocol/mpsc_frame_queue.hpp"
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+
+static_assert(configUSE_TRACING, "test_frame_trace is built with -DconfigUSE_TRACING=1");
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+using trace::TracePoint;
+
+namespace
+{
+    // Acknowledges every DATA frame
+    class AckingUart : public MockUart
+    {
+    public:
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            bool ok = MockUart::send_data(data, size);
+            if (ok && size > 3 && data[3] == config::DATA_TYPE)
+            {
+                append(rx, make_frame(config::ACK_TYPE));
+            }
+            return ok;
+        }
+    };
+
+    std::vector<TracePoint> points_of(const std::vector<trace::TraceRecord> &records, uint32_t frame_id)
+    {
+        std::vector<TracePoint> points;
+        for (const auto &record : records)
+        {
+            if (record.event.frame_id == frame_id)
+            {
+                points.push_back(static_cast<TracePoint>(record.event.point));
+            }
+        }
+        return points;
+    }
+} // namespace
+
+TEST(FrameTrace, FollowsOneFrameThroughTheAckRoundTrip)
+{
+    trace::collect(); // Drop events of earlier tests
+    AckingUart uart;
+    Protocol protocol(uart);
+    ASSERT_TRUE(protocol.send_frame_wait_ack(config::DATA_TYPE, {1, 2, 3}, 100));
+
+    auto records = trace::collect();
+    ASSERT_FALSE(records.empty());
+    uint32_t frame_id = records.front().event.frame_id;
+    EXPECT_NE(frame_id, 0u);
+    EXPECT_EQ(points_of(records, frame_id), (std::vector<TracePoint>{TracePoint::Encoded, TracePoint::SendData, TracePoint::FirstRxByte,
+                                                                     TracePoint::Parsed, TracePoint::AckMatched}));
+    for (size_t i = 1; i < records.size(); ++i)
+    {
+        EXPECT_LE(records[i - 1].event.timestamp_us, records[i].event.timestamp_us);
+    }
+}
+
+TEST(FrameTrace, SchedulerRecordsEachStagePerFrame)
+{
+    trace::collect();
+    TxScheduler<> scheduler;
+    scheduler.enqueue(config::DATA_TYPE, {1});
+    scheduler.enqueue(config::ACK_TYPE, {});
+    MockUart uart;
+    scheduler.drain(uart);
+
+    auto records = trace::collect();
+    ASSERT_EQ(records.size(), 6u);
+    uint32_t data_id = records[0].event.frame_id;
+    uint32_t ack_id = records[2].event.frame_id;
+    EXPECT_NE(data_id, ack_id);
+    const std::vector<TracePoint> stages{TracePoint::Enqueued, TracePoint::Encoded, TracePoint::SendData};
+    EXPECT_EQ(points_of(records, data_id), stages);
+    EXPECT_EQ(points_of(records, ack_id), stages);
+}
+
+TEST(FrameTrace, EventsFromSeveralThreadsAreCollected)
+{
+    trace::collect();
+    std::thread other([]
+                      { trace::record(TracePoint::Parsed, 77, config::DATA_TYPE, 1); });
+    other.join();
+    trace::record(TracePoint::Parsed, 78, config::DATA_TYPE, 1);
+
+    auto records = trace::collect();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_NE(records[0].thread_id, records[1].thread_id);
+}
+
+TEST(FrameTrace, WritesChromeTraceJson)
+{
+    trace::collect();
+    AckingUart uart;
+    Protocol protocol(uart);
+    protocol.send_frame_wait_ack(config::DATA_TYPE, {9}, 100);
+
+    std::string path = temp_path("uart_trace.json");
+    ASSERT_TRUE(trace::write_chrome_trace(path.c_str()));
+    auto bytes = read_file(path);
+    std::remove(path.c_str());
+    std::string json(bytes.begin(), bytes.end());
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"ack_matched\""), std::string::npos);
+    EXPECT_NE(json.find("]}"), std::string::npos);
+    EXPECT_TRUE(trace::collect().empty()); // Export drains the rings
+}
+
+TEST(FrameTrace, ConcurrentSendersKeepTheirOwnFrameIds)
+{
+    trace::collect();
+    MockUart uart;
+    ConcurrentSendUart<MockUart, 256> tx(uart);
+    BasicProtocol<ConcurrentSendUart<MockUart, 256>> protocol(tx);
+    constexpr size_t FRAMES = 80; // 3 * 80 fit into the queue without a drainer
+
+    std::vector<std::thread> senders;
+    for (uint8_t t = 0; t < 3; ++t)
+    {
+        senders.emplace_back([&protocol, t]
+                             {
+            for (size_t i = 0; i < FRAMES; ++i)
+            {
+                protocol.send_frame(config::DATA_TYPE, &t, 1);
+            } });
+    }
+    for (auto &sender : senders)
+    {
+        sender.join();
+    }
+
+    // The protocol records Encoded then SendData per frame: both carry the same ID, never shared with another frame
+    std::map<uint32_t, uint32_t> last_encoded; // thread -> frame ID
+    std::set<uint32_t> ids;
+    size_t pairs = 0;
+    for (const auto &record : trace::collect())
+    {
+        auto point = static_cast<TracePoint>(record.event.point);
+        if (point == TracePoint::Encoded)
+        {
+            last_encoded[record.thread_id] = record.event.frame_id;
+            EXPECT_TRUE(ids.insert(record.event.frame_id).second);
+        }
+        else if (point == TracePoint::SendData)
+        {
+            EXPECT_EQ(record.event.frame_id, last_encoded[record.thread_id]);
+            ++pairs;
+        }
+    }
+    EXPECT_EQ(pairs, 3 * FRAMES);
+}
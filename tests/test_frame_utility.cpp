@@ -0,0 +1,100 @@
+#include "test_utility.hpp"
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+
+TEST(FrameUtility, EncodeMatchesConstructFrame)
+{
+    Frame frame{config::DATA_TYPE, {0xDE, 0xAD, 0xBE, 0xEF}};
+    EXPECT_EQ(make_frame(frame.type, frame.payload), construct_frame(frame));
+}
+
+TEST(FrameUtility, EncodeRejectsOversizedPayload)
+{
+    std::vector<uint8_t> payload(256, 0x11);
+    uint8_t raw[MAX_FRAME_SIZE + 1];
+    EXPECT_EQ(encode_frame(config::DATA_TYPE, payload.data(), payload.size(), raw), 0u);
+}
+
+TEST(FrameUtility, DecodeFrameReturnsViewIntoBuffer)
+{
+    auto raw = make_frame(config::DATA_TYPE, {1, 2, 3});
+    FrameView view;
+    size_t consumed = 0;
+    ASSERT_EQ(decode_frame(raw.data(), raw.size(), view, consumed), ParseStatus::Ok);
+    EXPECT_EQ(consumed, raw.size());
+    EXPECT_EQ(view.type, config::DATA_TYPE);
+    EXPECT_EQ(view.payload, raw.data() + 4);
+    EXPECT_EQ(view.payload_size, 3u);
+}
+
+TEST(FrameUtility, DecodeFrameNeedsMoreDataForEveryPrefix)
+{
+    auto raw = make_frame(config::DATA_TYPE, {1, 2, 3});
+    for (size_t len = 0; len < raw.size(); ++len)
+    {
+        FrameView view;
+        size_t consumed = 0;
+        EXPECT_EQ(decode_frame(raw.data(), len, view, consumed), ParseStatus::NeedMoreData) << "prefix " << len;
+        EXPECT_EQ(consumed, 0u);
+    }
+}
+
+TEST(FrameUtility, DecodeFrameSkipsToNextStartWordOnCrcError)
+{
+    std::vector<uint8_t> stream = make_frame(config::DATA_TYPE, {1, 2, 3});
+    stream.back() ^= 0x01;
+    size_t bad_size = stream.size();
+    append(stream, make_frame(config::ACK_TYPE));
+
+    FrameView view;
+    size_t consumed = 0;
+    ASSERT_EQ(decode_frame(stream.data(), stream.size(), view, consumed), ParseStatus::Invalid);
+    EXPECT_EQ(consumed, bad_size);
+}
+
+TEST(FrameUtility, FindStartWordKeepsTrailingFirstByte)
+{
+    const uint8_t data[] = {0x00, 0xAA, 0x55, 0x01, 0x55}; // START_WORD is 0x55 0xAA on the wire
+    EXPECT_EQ(find_start_word(data, sizeof(data)), 4u);
+    const uint8_t none[] = {0x00, 0x01};
+    EXPECT_EQ(find_start_word(none, sizeof(none)), sizeof(none));
+}
+
+TEST(FrameUtility, DecodeFramesParsesBurstInOnePass)
+{
+    std::vector<uint8_t> stream;
+    stream.push_back(0x42); // garbage
+    append(stream, make_frame(config::DATA_TYPE, {1}));
+    auto corrupt = make_frame(config::DATA_TYPE, {2});
+    corrupt[4] ^= 0xFF;
+    append(stream, corrupt);
+    append(stream, make_frame(config::ACK_TYPE));
+    append(stream, make_frame(config::DATA_TYPE, {3}));
+    auto partial = make_frame(config::DATA_TYPE, {4, 5, 6});
+    stream.insert(stream.end(), partial.begin(), partial.begin() + 5);
+
+    FrameView views[8];
+    size_t consumed = 0;
+    size_t count = decode_frames(stream.data(), stream.size(), views, 8, consumed);
+    ASSERT_EQ(count, 3u);
+    EXPECT_EQ(views[0].payload[0], 1);
+    EXPECT_EQ(views[1].type, config::ACK_TYPE);
+    EXPECT_EQ(views[2].payload[0], 3);
+    EXPECT_EQ(consumed, stream.size() - 5); // The partial frame stays
+}
+
+TEST(FrameUtility, DecodeFramesStopsWhenOutputIsFull)
+{
+    std::vector<uint8_t> stream;
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        append(stream, make_frame(config::DATA_TYPE, {i}));
+    }
+    FrameView views[2];
+    size_t consumed = 0;
+    ASSERT_EQ(decode_frames(stream.data(), stream.size(), views, 2, consumed), 2u);
+    EXPECT_EQ(consumed, stream.size() / 2);
+    ASSERT_EQ(decode_frames(stream.data() + consumed, stream.size() - consumed, views, 2, consumed), 2u);
+    EXPECT_EQ(views[1].payload[0], 3);
+}
@@ -0,0 +1,144 @@
+#include "test_utility.hpp"
+#include "uart_protocol/link_monitor.hpp"
+
+using namespace uart_protocol;
+
+namespace
+{
+    // Far end of one link: answers probes with an ACK on the next tick while alive
+    struct Peer
+    {
+        bool alive = true;
+        bool answer_due = false;
+        std::vector<uint8_t> sent;
+        std::vector<LinkState> states;
+    };
+
+    bool send(void *context, uint8_t type)
+    {
+        auto *peer = static_cast<Peer *>(context);
+        peer->sent.push_back(type);
+        if (type == config::ARE_YOU_THERE_TYPE && peer->alive)
+        {
+            peer->answer_due = true;
+        }
+        return true;
+    }
+
+    void on_change(void *context, LinkState, LinkState current)
+    {
+        static_cast<Peer *>(context)->states.push_back(current);
+    }
+
+    struct Fixture
+    {
+        TimerWheel wheel{0};
+        LinkMonitor monitor{wheel};
+        LinkLiveness link;
+        Peer peer;
+
+        Fixture() { monitor.add(link, send, on_change, &peer); }
+
+        // Advance the wheel one millisecond at a time, delivering the peer's answers
+        void run(uint32_t ms)
+        {
+            for (uint32_t i = 0; i < ms; ++i)
+            {
+                wheel.advance(wheel.now() + 1);
+                if (peer.answer_due)
+                {
+                    peer.answer_due = false;
+                    monitor.on_frame(link, config::ACK_TYPE);
+                }
+            }
+        }
+
+        // Run until the link leaves `state`. Returns the elapsed milliseconds (limit if it never does).
+        uint32_t run_while(LinkState state, uint32_t limit)
+        {
+            uint32_t elapsed = 0;
+            while (link.state() == state && elapsed < limit)
+            {
+                run(1);
+                ++elapsed;
+            }
+            return elapsed;
+        }
+
+        size_t probes() const { return link.probes_sent(); }
+    };
+} // namespace
+
+TEST(LinkMonitor, ComesUpAfterConsecutiveAnswers)
+{
+    Fixture f;
+    EXPECT_EQ(f.link.state(), LinkState::Down);
+    f.run(2);
+    EXPECT_EQ(f.link.state(), LinkState::Degraded); // First answer
+    f.run(config::LINK_PROBE_TIMEOUT_MS + 10);      // Confirmed by the next probe, no idle wait
+    EXPECT_EQ(f.link.state(), LinkState::Up);
+    EXPECT_EQ(f.peer.states, (std::vector<LinkState>{LinkState::Degraded, LinkState::Up}));
+}
+
+TEST(LinkMonitor, BusyLinkIsNeverProbed)
+{
+    Fixture f;
+    f.run(2000);
+    ASSERT_TRUE(f.link.up());
+    size_t probes = f.probes();
+    for (int i = 0; i < 100; ++i)
+    {
+        f.monitor.on_frame(f.link, config::DATA_TYPE);
+        f.run(100);
+    }
+    EXPECT_EQ(f.probes(), probes);
+    EXPECT_TRUE(f.link.up());
+}
+
+TEST(LinkMonitor, SilentPeerGoesDegradedThenDown)
+{
+    Fixture f;
+    f.run(2000);
+    ASSERT_TRUE(f.link.up());
+    f.peer.alive = false;
+    f.peer.states.clear();
+
+    // The next idle probe goes unanswered, then one probe timeout per further miss
+    EXPECT_LE(f.run_while(LinkState::Up, 5000), config::LINK_IDLE_MS + config::LINK_PROBE_TIMEOUT_MS);
+    EXPECT_EQ(f.link.state(), LinkState::Degraded);
+    EXPECT_EQ(f.run_while(LinkState::Degraded, 5000), config::LINK_PROBE_TIMEOUT_MS * (config::LINK_DOWN_AFTER - config::LINK_DEGRADED_AFTER));
+    EXPECT_EQ(f.link.state(), LinkState::Down);
+    EXPECT_EQ(f.peer.states, (std::vector<LinkState>{LinkState::Degraded, LinkState::Down}));
+
+    // A down link is only probed every LINK_DOWN_PROBE_INTERVAL_MS
+    size_t probes = f.probes();
+    f.run(config::LINK_DOWN_PROBE_INTERVAL_MS * 3);
+    EXPECT_LE(f.probes() - probes, 3u);
+}
+
+TEST(LinkMonitor, StrayAnswerDoesNotFlapTheLinkUp)
+{
+    Fixture f;
+    f.peer.alive = false;
+    f.run(config::LINK_DOWN_PROBE_INTERVAL_MS + 10);
+    ASSERT_EQ(f.link.state(), LinkState::Down);
+
+    f.monitor.on_frame(f.link, config::DATA_TYPE); // One frame, then silence again
+    EXPECT_EQ(f.link.state(), LinkState::Degraded);
+    f.run(config::LINK_PROBE_TIMEOUT_MS * (config::LINK_DOWN_AFTER + 1) + 10);
+    EXPECT_EQ(f.link.state(), LinkState::Down);
+    EXPECT_EQ(f.peer.states, (std::vector<LinkState>{LinkState::Degraded, LinkState::Down}));
+}
+
+TEST(LinkMonitor, AnswersThePeersProbe)
+{
+    Fixture f;
+    f.peer.sent.clear();
+    f.monitor.on_frame(f.link, config::ARE_YOU_THERE_TYPE);
+    EXPECT_EQ(f.peer.sent, (std::vector<uint8_t>{config::ACK_TYPE}));
+
+    f.monitor.remove(f.link);
+    EXPECT_FALSE(f.link.monitored());
+    EXPECT_EQ(f.monitor.links(), 0u);
+    EXPECT_EQ(f.wheel.armed(), 0u);
+}
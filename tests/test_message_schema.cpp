@@ -0,0 +1,135 @@
+#include "test_utility.hpp"
+#include "uart_protocol/message_schema.hpp"
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+
+namespace
+{
+    enum class Mode : uint8_t
+    {
+        Idle = 1,
+        Run = 2
+    };
+
+    struct Position
+    {
+        int16_t x;
+        int16_t y;
+    };
+
+    struct Telemetry
+    {
+        uint16_t id;
+        int32_t temperature;
+        float voltage;
+        Mode mode;
+        bool alarm;
+        std::array<uint8_t, 3> raw;
+        Position position;
+    };
+
+    struct BigEndianWord
+    {
+        uint32_t value;
+    };
+} // namespace
+
+template <>
+struct uart_protocol::MessageSchema<Position>
+{
+    static constexpr uint8_t frame_type = config::DATA_TYPE;
+    static constexpr auto fields = schema_fields(&Position::x, &Position::y);
+};
+
+template <>
+struct uart_protocol::MessageSchema<Telemetry>
+{
+    static constexpr uint8_t frame_type = config::DATA_TYPE;
+    static constexpr auto fields = schema_fields(&Telemetry::id, &Telemetry::temperature, &Telemetry::voltage,
+                                                 &Telemetry::mode, &Telemetry::alarm, &Telemetry::raw, &Telemetry::position);
+};
+
+template <>
+struct uart_protocol::MessageSchema<BigEndianWord>
+{
+    static constexpr uint8_t frame_type = config::CMD_TYPE;
+    static constexpr WireOrder byte_order = WireOrder::Big;
+    static constexpr auto fields = schema_fields(&BigEndianWord::value);
+};
+
+static_assert(message_wire_size<Position> == 4);
+static_assert(message_wire_size<Telemetry> == 2 + 4 + 4 + 1 + 1 + 3 + 4);
+static_assert(message_frame_size<Telemetry> == FRAME_OVERHEAD + 19);
+
+TEST(MessageSchema, RoundTripThroughAFrame)
+{
+    Telemetry sent{0x1234, -40, 3.3f, Mode::Run, true, {7, 8, 9}, {-1, 300}};
+    uint8_t raw[message_frame_size<Telemetry>];
+    ASSERT_EQ(encode_message(sent, raw), sizeof(raw));
+
+    FrameView frame;
+    size_t consumed = 0;
+    ASSERT_EQ(decode_frame(raw, sizeof(raw), frame, consumed), ParseStatus::Ok);
+    Telemetry received{};
+    ASSERT_TRUE(decode_message(frame, received));
+    EXPECT_EQ(received.id, sent.id);
+    EXPECT_EQ(received.temperature, sent.temperature);
+    EXPECT_EQ(received.voltage, sent.voltage);
+    EXPECT_EQ(received.mode, sent.mode);
+    EXPECT_EQ(received.alarm, sent.alarm);
+    EXPECT_EQ(received.raw, sent.raw);
+    EXPECT_EQ(received.position.x, -1);
+    EXPECT_EQ(received.position.y, 300);
+}
+
+TEST(MessageSchema, LittleEndianByDefaultBigOnRequest)
+{
+    Position position{0x0102, 0x0304};
+    uint8_t payload[4];
+    serialize_message(position, payload);
+    EXPECT_EQ(std::vector<uint8_t>(payload, payload + 4), (std::vector<uint8_t>{0x02, 0x01, 0x04, 0x03}));
+
+    BigEndianWord word{0x0A0B0C0D};
+    serialize_message(word, payload);
+    EXPECT_EQ(std::vector<uint8_t>(payload, payload + 4), (std::vector<uint8_t>{0x0A, 0x0B, 0x0C, 0x0D}));
+}
+
+TEST(MessageSchema, RejectsWrongTypeOrSize)
+{
+    Position position{};
+    const uint8_t short_payload[] = {1, 2, 3};
+    EXPECT_FALSE(deserialize_message(short_payload, sizeof(short_payload), position));
+
+    auto raw = make_frame(config::CMD_TYPE, {1, 2, 3, 4});
+    FrameView frame;
+    size_t consumed = 0;
+    ASSERT_EQ(decode_frame(raw.data(), raw.size(), frame, consumed), ParseStatus::Ok);
+    EXPECT_FALSE(decode_message(frame, position));
+    BigEndianWord word{};
+    EXPECT_TRUE(decode_message(frame, word));
+    EXPECT_EQ(word.value, 0x01020304u);
+}
+
+TEST(MessageSchema, SendMessageWritesTheEncodedFrame)
+{
+    MockUart uart;
+    Protocol protocol(uart);
+    Telemetry telemetry{1, 2, 0.5f, Mode::Idle, false, {0, 0, 0}, {0, 0}};
+    ASSERT_TRUE(send_message(protocol, telemetry));
+
+    uint8_t expected[message_frame_size<Telemetry>];
+    encode_message(telemetry, expected);
+    ASSERT_EQ(uart.writes.size(), 1u);
+    EXPECT_EQ(uart.writes[0], std::vector<uint8_t>(expected, expected + sizeof(expected)));
+}
+
+TEST(MessageSchema, SendEncodedRejectsInvalidSizes)
+{
+    MockUart uart;
+    Protocol protocol(uart);
+    uint8_t frame[MAX_FRAME_SIZE + 1] = {};
+    EXPECT_FALSE(protocol.send_encoded(frame, FRAME_OVERHEAD - 1));
+    EXPECT_FALSE(protocol.send_encoded(frame, MAX_FRAME_SIZE + 1));
+    EXPECT_TRUE(uart.writes.empty());
+}
@@ -0,0 +1,94 @@
+#include "test_utility.hpp"
+#include "uart_protocol/mpsc_frame_queue.hpp"
+#include "uart_protocol/protocol.hpp"
+#include <thread>
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+
+TEST(MpscFrameQueue, DrainsInQueueOrder)
+{
+    MpscFrameQueue<4> queue;
+    const uint8_t one[] = {1};
+    auto raw = make_frame(config::ACK_TYPE);
+    EXPECT_EQ(queue.push_frame(config::DATA_TYPE, one, 1), TxStatus::Queued);
+    EXPECT_EQ(queue.push_raw(raw.data(), raw.size()), TxStatus::Queued);
+    EXPECT_EQ(queue.pending(), 2u);
+
+    MockUart uart;
+    EXPECT_EQ(queue.drain(uart), 2u);
+    EXPECT_EQ(uart.writes[0], make_frame(config::DATA_TYPE, {1}));
+    EXPECT_EQ(uart.writes[1], raw);
+    EXPECT_EQ(queue.pending(), 0u);
+}
+
+TEST(MpscFrameQueue, FullQueueRejectsAndRecoversAfterDrain)
+{
+    MpscFrameQueue<2> queue;
+    EXPECT_EQ(queue.push_frame(config::DATA_TYPE, nullptr, 0), TxStatus::Queued);
+    EXPECT_EQ(queue.push_frame(config::DATA_TYPE, nullptr, 0), TxStatus::Queued);
+    EXPECT_EQ(queue.push_frame(config::DATA_TYPE, nullptr, 0), TxStatus::QueueFull);
+    EXPECT_EQ(queue.rejected(), 1u);
+
+    MockUart uart;
+    uart.refuse_writes = 1;
+    EXPECT_EQ(queue.drain(uart), 0u);
+    EXPECT_EQ(queue.pending(), 2u);
+    EXPECT_EQ(queue.drain(uart, 1), 1u);
+    EXPECT_EQ(queue.push_frame(config::DATA_TYPE, nullptr, 0), TxStatus::Queued);
+}
+
+TEST(MpscFrameQueue, ConcurrentProducersDeliverEveryFrameWhole)
+{
+    constexpr size_t PRODUCERS = 4;
+    constexpr size_t FRAMES_PER_PRODUCER = 2000;
+
+    MockUart uart;
+    ConcurrentSendUart<MockUart, 64> tx(uart);
+    BasicProtocol<ConcurrentSendUart<MockUart, 64>> protocol(tx);
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < PRODUCERS; ++p)
+    {
+        producers.emplace_back([&protocol, &tx, p]
+                               {
+            for (size_t i = 0; i < FRAMES_PER_PRODUCER; ++i)
+            {
+                EXPECT_LE(tx.queue().pending(), 64u); // Snapshot from a producer thread
+                const uint8_t payload[] = {static_cast<uint8_t>(p), static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8)};
+                while (!protocol.send_frame(config::DATA_TYPE, payload, sizeof(payload)))
+                {
+                    std::this_thread::yield(); // Queue full: wait for the drainer
+                }
+            } });
+    }
+
+    size_t drained = 0;
+    while (drained < PRODUCERS * FRAMES_PER_PRODUCER)
+    {
+        drained += tx.drain();
+        std::this_thread::yield();
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+
+    // Every write is one valid frame, and each producer's frames arrive in its own order
+    size_t next[PRODUCERS] = {};
+    for (const auto &write : uart.writes)
+    {
+        FrameView frame;
+        size_t consumed = 0;
+        ASSERT_EQ(decode_frame(write.data(), write.size(), frame, consumed), ParseStatus::Ok);
+        ASSERT_EQ(consumed, write.size());
+        size_t p = frame.payload[0];
+        size_t i = frame.payload[1] | (static_cast<size_t>(frame.payload[2]) << 8);
+        ASSERT_LT(p, PRODUCERS);
+        EXPECT_EQ(i, next[p]++);
+    }
+    for (size_t p = 0; p < PRODUCERS; ++p)
+    {
+        EXPECT_EQ(next[p], FRAMES_PER_PRODUCER);
+    }
+}
@@ -0,0 +1,146 @@
+#include "test_utility.hpp"
+#include "uart_protocol/parallel_decoder.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+
+namespace
+{
+    // Frames with noise in between, some carrying a complete encoded frame in their payload
+    // (a worker starting inside such a frame decodes the embedded one first), and a cut off tail
+    std::vector<uint8_t> make_stream(size_t frames)
+    {
+        std::mt19937 rng(42);
+        std::vector<uint8_t> stream;
+        for (size_t i = 0; i < frames; ++i)
+        {
+            if (rng() % 5 == 0)
+            {
+                stream.push_back(0x55);
+                stream.push_back(static_cast<uint8_t>(rng()));
+            }
+            std::vector<uint8_t> payload;
+            if (rng() % 4 == 0)
+            {
+                payload = make_frame(config::CMD_TYPE, {static_cast<uint8_t>(i), 1, 2});
+            }
+            payload.resize(payload.size() + rng() % 60, static_cast<uint8_t>(i));
+            append(stream, make_frame(static_cast<uint8_t>(config::DATA_TYPE + rng() % 2), payload));
+        }
+        auto tail = make_frame(config::DATA_TYPE, std::vector<uint8_t>(50, 0xEE));
+        stream.insert(stream.end(), tail.begin(), tail.begin() + 20);
+        return stream;
+    }
+
+    std::vector<FrameIndexEntry> decode_sequential(const std::vector<uint8_t> &stream)
+    {
+        std::vector<FrameIndexEntry> entries;
+        size_t pos = 0;
+        while (pos < stream.size())
+        {
+            FrameView view;
+            size_t consumed = 0;
+            ParseStatus status = decode_frame(stream.data() + pos, stream.size() - pos, view, consumed);
+            if (status == ParseStatus::NeedMoreData)
+            {
+                consumed = find_start_word(stream.data() + pos, stream.size() - pos, 1);
+            }
+            else if (status == ParseStatus::Ok)
+            {
+                entries.push_back({pos, static_cast<uint16_t>(consumed), view.type});
+            }
+            pos += consumed;
+        }
+        return entries;
+    }
+
+    bool same_entries(const std::vector<FrameIndexEntry> &a, const std::vector<FrameIndexEntry> &b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const FrameIndexEntry &x, const FrameIndexEntry &y)
+                                                  { return x.offset == y.offset && x.size == y.size && x.type == y.type; });
+    }
+} // namespace
+
+TEST(FrameIndex, ParallelBuildMatchesSequentialDecode)
+{
+    auto stream = make_stream(5000);
+    auto expected = decode_sequential(stream);
+    ASSERT_EQ(expected.size(), 5000u); // Embedded frames are payload, not frames of the stream
+
+    for (unsigned threads : {1u, 2u, 3u, 7u, 16u})
+    {
+        FrameIndex index = FrameIndex::build(stream.data(), stream.size(), threads);
+        EXPECT_TRUE(same_entries(index.entries(), expected)) << threads << " threads";
+
+        uint64_t covered = 0;
+        for (const auto &entry : expected)
+        {
+            covered += entry.size;
+        }
+        EXPECT_EQ(index.skipped_bytes(), stream.size() - covered) << threads << " threads";
+    }
+}
+
+TEST(FrameIndex, RandomAccessViewsPointIntoTheStream)
+{
+    auto stream = make_stream(100);
+    FrameIndex index = FrameIndex::build(stream.data(), stream.size(), 2);
+    ASSERT_FALSE(index.empty());
+    for (size_t n = 0; n < index.size(); ++n)
+    {
+        FrameView view = index.frame(stream.data(), n);
+        EXPECT_EQ(view.type, index[n].type);
+        EXPECT_EQ(view.payload, stream.data() + index[n].offset + 4);
+        EXPECT_EQ(view.payload_size + FRAME_OVERHEAD, index[n].size);
+    }
+}
+
+TEST(FrameIndex, SaveLoadRoundTrip)
+{
+    auto stream = make_stream(300);
+    FrameIndex index = FrameIndex::build(stream.data(), stream.size(), 2);
+    std::string path = temp_path("frame_index_roundtrip.upidx");
+    ASSERT_TRUE(index.save(path.c_str()));
+
+    FrameIndex loaded;
+    ASSERT_TRUE(loaded.load(path.c_str()));
+    EXPECT_TRUE(same_entries(loaded.entries(), index.entries()));
+    EXPECT_EQ(loaded.skipped_bytes(), index.skipped_bytes());
+    std::remove(path.c_str());
+}
+
+TEST(FrameIndex, LoadRejectsCorruptFiles)
+{
+    auto stream = make_stream(50);
+    FrameIndex index = FrameIndex::build(stream.data(), stream.size(), 1);
+    std::string path = temp_path("frame_index_corrupt.upidx");
+    ASSERT_TRUE(index.save(path.c_str()));
+    auto good = read_file(path);
+    ASSERT_EQ(good.size(), 16 + 11 * index.size());
+
+    FrameIndex loaded;
+
+    auto huge_count = good;
+    huge_count[7] = 0x7F; // COUNT far beyond the file size: rejected before allocating
+    ASSERT_TRUE(write_file(path, huge_count));
+    EXPECT_FALSE(loaded.load(path.c_str()));
+    EXPECT_TRUE(loaded.empty());
+    EXPECT_EQ(loaded.skipped_bytes(), 0u);
+
+    auto truncated = good;
+    truncated.resize(good.size() - 5);
+    ASSERT_TRUE(write_file(path, truncated));
+    EXPECT_FALSE(loaded.load(path.c_str()));
+
+    auto bad_size = good;
+    bad_size[16 + 8] = 2; // First entry claims a 2-byte frame
+    bad_size[16 + 9] = 0;
+    ASSERT_TRUE(write_file(path, bad_size));
+    EXPECT_FALSE(loaded.load(path.c_str()));
+    EXPECT_TRUE(loaded.empty());
+
+    EXPECT_FALSE(loaded.load(temp_path("does_not_exist.upidx").c_str()));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,144 @@
+#include "test_utility.hpp"
+#include "uart_protocol/protocol.hpp"
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+
+namespace
+{
+    // Answers every DATA frame with a scripted reply
+    class ReplyUart : public MockUart
+    {
+    public:
+        std::vector<uint8_t> reply;
+
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            bool ok = MockUart::send_data(data, size);
+            if (ok && size > 3 && data[3] == config::DATA_TYPE)
+            {
+                append(rx, reply);
+            }
+            return ok;
+        }
+    };
+
+    class CountingUart : public MockUart
+    {
+    public:
+        size_t overridden_sends = 0;
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            ++overridden_sends;
+            return MockUart::send_data(data, size);
+        }
+    };
+
+    struct FinalUart final : MockUart
+    {
+    };
+} // namespace
+
+TEST(Protocol, SendFrameWritesOneEncodedFrame)
+{
+    MockUart uart;
+    Protocol protocol(uart);
+    ASSERT_TRUE(protocol.send_frame(config::DATA_TYPE, {1, 2}));
+    ASSERT_EQ(uart.writes.size(), 1u);
+    EXPECT_EQ(uart.writes[0], make_frame(config::DATA_TYPE, {1, 2}));
+    EXPECT_FALSE(protocol.send_frame(config::DATA_TYPE, std::vector<uint8_t>(config::MAX_PAYLOAD_SIZE + 1)));
+}
+
+TEST(Protocol, StaticBindingKeepsSubclassOverrides)
+{
+    // BasicProtocol<MockUart> must still reach CountingUart::send_data (MockUart is not final)
+    CountingUart uart;
+    BasicProtocol<MockUart> protocol(uart);
+    protocol.send_ack();
+    EXPECT_EQ(uart.overridden_sends, 1u);
+
+    static_assert(!is_statically_bound_v<MockUart>);
+    static_assert(is_statically_bound_v<FinalUart>);
+    static_assert(!is_statically_bound_v<Uart>);
+}
+
+TEST(Protocol, ReceiveFramesReturnsWholeBurst)
+{
+    MockUart uart;
+    uart.chunk_size = 5;
+    for (uint8_t i = 0; i < 10; ++i)
+    {
+        append(uart.rx, make_frame(config::DATA_TYPE, {i}));
+    }
+    Protocol protocol(uart);
+
+    FrameView frames[16];
+    ASSERT_EQ(protocol.receive_frames(frames, 16), 10u);
+    for (uint8_t i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(frames[i].payload[0], i);
+    }
+    EXPECT_EQ(protocol.receive_frames(frames, 16), 0u);
+}
+
+TEST(Protocol, ReceiveFramesKeepsFramesThatDoNotFit)
+{
+    MockUart uart;
+    for (uint8_t i = 0; i < 5; ++i)
+    {
+        append(uart.rx, make_frame(config::DATA_TYPE, {i}));
+    }
+    Protocol protocol(uart);
+
+    FrameView frames[2];
+    std::vector<uint8_t> seen;
+    size_t count;
+    while ((count = protocol.receive_frames(frames, 2)) > 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            seen.push_back(frames[i].payload[0]);
+        }
+    }
+    EXPECT_EQ(seen, (std::vector<uint8_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(Protocol, ReceiveFramesCompletesSplitFrame)
+{
+    MockUart uart;
+    auto frame = make_frame(config::DATA_TYPE, {7, 8, 9});
+    uart.rx.assign(frame.begin(), frame.begin() + 4);
+    Protocol protocol(uart);
+
+    FrameView frames[4];
+    EXPECT_EQ(protocol.receive_frames(frames, 4), 0u);
+    uart.rx.assign(frame.begin() + 4, frame.end());
+    ASSERT_EQ(protocol.receive_frames(frames, 4), 1u);
+    EXPECT_EQ(frames[0].payload[2], 9);
+}
+
+TEST(Protocol, WaitAckKeepsOtherFrames)
+{
+    ReplyUart uart;
+    append(uart.reply, make_frame(config::DATA_TYPE, {1}));
+    append(uart.reply, make_frame(config::ACK_TYPE));
+    append(uart.reply, make_frame(config::CMD_TYPE, {2}));
+    Protocol protocol(uart);
+
+    ASSERT_TRUE(protocol.send_frame_wait_ack(config::DATA_TYPE, {0x55}, 100));
+
+    FrameView frames[4];
+    ASSERT_EQ(protocol.receive_frames(frames, 4), 2u);
+    EXPECT_EQ(frames[0].type, config::DATA_TYPE);
+    EXPECT_EQ(frames[0].payload[0], 1);
+    EXPECT_EQ(frames[1].type, config::CMD_TYPE);
+}
+
+TEST(Protocol, WaitAckTimesOutWithoutAck)
+{
+    ReplyUart uart;
+    append(uart.reply, make_frame(config::NACK_TYPE));
+    Protocol protocol(uart);
+    EXPECT_FALSE(protocol.send_frame_wait_ack(config::DATA_TYPE, {1}, 5));
+    EXPECT_FALSE(protocol.send_frame_wait_ack_us(config::DATA_TYPE, {1}, 500));
+}
@@ -0,0 +1,178 @@
+#include "test_utility.hpp"
+#include "uart_protocol/protocol_engine.hpp"
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+
+namespace
+{
+    using Engine = ProtocolEngine<MockUart, 4>;
+
+    struct Outcomes
+    {
+        std::vector<std::pair<SendHandle, SendStatus>> completed;
+        std::vector<uint8_t> received_types;
+    };
+
+    void on_sent(void *context, SendHandle handle, SendStatus status)
+    {
+        static_cast<Outcomes *>(context)->completed.emplace_back(handle, status);
+    }
+
+    void on_frame(void *context, const FrameView &frame)
+    {
+        static_cast<Outcomes *>(context)->received_types.push_back(frame.type);
+    }
+
+    struct Fixture
+    {
+        MockUart uart;
+        BasicProtocol<MockUart> protocol{uart};
+        Engine engine{protocol};
+        Outcomes outcomes;
+
+        Fixture()
+        {
+            engine.set_frame_handler(on_frame, &outcomes);
+            engine.set_ack_timeout_ms(100);
+        }
+
+        SendHandle send(uint8_t value)
+        {
+            return engine.send(config::DATA_TYPE, &value, 1, on_sent, &outcomes);
+        }
+    };
+} // namespace
+
+TEST(ProtocolEngine, SendsOneFrameAtATimeAndCompletesOnAck)
+{
+    Fixture f;
+    SendHandle first = f.send(1);
+    SendHandle second = f.send(2);
+    EXPECT_EQ(f.engine.status(first), SendStatus::Queued);
+    EXPECT_TRUE(f.uart.writes.empty()); // send() never touches the driver
+
+    f.engine.step(1000);
+    ASSERT_EQ(f.uart.writes.size(), 1u);
+    EXPECT_EQ(f.uart.writes[0], make_frame(config::DATA_TYPE, {1}));
+    EXPECT_EQ(f.engine.status(first), SendStatus::AwaitingAck);
+    f.engine.step(1010);
+    EXPECT_EQ(f.uart.writes.size(), 1u); // Stop-and-wait
+
+    f.uart.rx = make_frame(config::ACK_TYPE);
+    EXPECT_EQ(f.engine.step(1020), 1u);
+    EXPECT_EQ(f.engine.status(first), SendStatus::Acked);
+    ASSERT_EQ(f.uart.writes.size(), 2u);
+    EXPECT_EQ(f.uart.writes[1], make_frame(config::DATA_TYPE, {2}));
+    ASSERT_EQ(f.outcomes.completed.size(), 1u);
+    EXPECT_EQ(f.outcomes.completed[0], std::make_pair(first, SendStatus::Acked));
+    EXPECT_EQ(f.engine.status(second), SendStatus::AwaitingAck);
+}
+
+TEST(ProtocolEngine, RetransmitsThenFails)
+{
+    Fixture f;
+    SendHandle handle = f.send(7);
+    uint32_t now = 5000;
+    f.engine.step(now);
+    for (uint8_t retry = 0; retry < config::ENGINE_MAX_RETRIES; ++retry)
+    {
+        now += 99;
+        f.engine.step(now);
+        EXPECT_EQ(f.uart.writes.size(), retry + 1u); // Not due yet
+        now += 1;
+        f.engine.step(now);
+        EXPECT_EQ(f.uart.writes.size(), retry + 2u);
+    }
+    EXPECT_EQ(f.engine.retransmits(), config::ENGINE_MAX_RETRIES);
+
+    f.engine.step(now + 100);
+    EXPECT_EQ(f.engine.status(handle), SendStatus::Failed);
+    EXPECT_TRUE(f.engine.idle());
+    ASSERT_EQ(f.outcomes.completed.size(), 1u);
+    EXPECT_EQ(f.outcomes.completed[0].second, SendStatus::Failed);
+}
+
+TEST(ProtocolEngine, LongStallFiresTheTimeoutOnce)
+{
+    Fixture f;
+    f.send(1);
+    f.engine.step(0);
+    f.engine.step(600000); // Loop stalled for ten minutes: one compare, one retransmit
+    EXPECT_EQ(f.engine.retransmits(), 1u);
+    EXPECT_EQ(f.uart.writes.size(), 2u);
+}
+
+TEST(ProtocolEngine, DeadlineSurvivesClockWrap)
+{
+    Fixture f;
+    f.send(1);
+    f.engine.step(UINT32_MAX - 50);
+    f.engine.step(20); // 71 ms later
+    EXPECT_EQ(f.engine.retransmits(), 0u);
+    f.engine.step(49);
+    EXPECT_EQ(f.engine.retransmits(), 1u);
+}
+
+TEST(ProtocolEngine, OtherFramesGoToTheHandler)
+{
+    Fixture f;
+    append(f.uart.rx, make_frame(config::CMD_TYPE, {1}));
+    append(f.uart.rx, make_frame(config::ACK_TYPE)); // Late ACK: nothing awaits it
+    append(f.uart.rx, make_frame(config::DATA_TYPE, {2}));
+    EXPECT_EQ(f.engine.step(0), 3u);
+    EXPECT_EQ(f.outcomes.received_types, (std::vector<uint8_t>{config::CMD_TYPE, config::DATA_TYPE}));
+}
+
+TEST(ProtocolEngine, CancelQueuedAndInFlightFrames)
+{
+    Fixture f;
+    SendHandle first = f.send(1);
+    SendHandle second = f.send(2);
+    SendHandle third = f.send(3);
+    f.engine.step(0);
+
+    EXPECT_TRUE(f.engine.cancel(second)); // Queued: skipped when it reaches the head
+    EXPECT_TRUE(f.engine.cancel(first));  // In flight: the next frame goes out once its ACK deadline passed
+    EXPECT_FALSE(f.engine.cancel(first));
+    f.engine.step(99);
+    EXPECT_EQ(f.uart.writes.size(), 1u);
+    f.engine.step(100);
+    ASSERT_EQ(f.uart.writes.size(), 2u);
+    EXPECT_EQ(f.uart.writes[1], make_frame(config::DATA_TYPE, {3}));
+    EXPECT_EQ(f.engine.status(third), SendStatus::AwaitingAck);
+    EXPECT_EQ(f.outcomes.completed.size(), 2u);
+}
+
+TEST(ProtocolEngine, LateAckOfCancelledFrameDoesNotAckTheNextOne)
+{
+    Fixture f;
+    SendHandle first = f.send(1);
+    SendHandle second = f.send(2);
+    f.engine.step(0);
+    ASSERT_TRUE(f.engine.cancel(first));
+    f.engine.step(10);
+    EXPECT_EQ(f.uart.writes.size(), 1u); // Held while the cancelled frame's ACK may still come
+
+    f.uart.rx = make_frame(config::ACK_TYPE); // Late ACK of the cancelled frame: swallowed, releases the hold
+    f.engine.step(20);
+    EXPECT_EQ(f.engine.status(second), SendStatus::AwaitingAck);
+    ASSERT_EQ(f.uart.writes.size(), 2u);
+    EXPECT_EQ(f.uart.writes[1], make_frame(config::DATA_TYPE, {2}));
+
+    f.uart.rx = make_frame(config::ACK_TYPE); // The second frame's own ACK
+    f.engine.step(30);
+    EXPECT_EQ(f.engine.status(second), SendStatus::Acked);
+    EXPECT_EQ(f.outcomes.completed, (std::vector<std::pair<SendHandle, SendStatus>>{{first, SendStatus::Cancelled}, {second, SendStatus::Acked}}));
+}
+
+TEST(ProtocolEngine, FullQueueReturnsNoHandle)
+{
+    Fixture f;
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        EXPECT_NE(f.send(i), 0u);
+    }
+    EXPECT_EQ(f.send(4), 0u);
+    EXPECT_EQ(f.engine.status(12345), SendStatus::Unknown);
+}
@@ -0,0 +1,102 @@
+#include "test_utility.hpp"
+#include "uart_protocol/stream_decoder.hpp"
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+
+namespace
+{
+    // Stream of frames with payload sizes 0..count-1 (first payload byte = index), garbage in between
+    std::vector<uint8_t> make_stream(size_t count, bool with_garbage)
+    {
+        std::vector<uint8_t> stream;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (with_garbage && i % 3 == 0)
+            {
+                stream.push_back(0x55); // looks like the first START_WORD byte
+                stream.push_back(0x13);
+            }
+            std::vector<uint8_t> payload(i % 40, static_cast<uint8_t>(i));
+            append(stream, make_frame(config::DATA_TYPE, payload));
+        }
+        return stream;
+    }
+
+    std::vector<size_t> decode_in_chunks(const std::vector<uint8_t> &stream, size_t chunk, StreamDecoder &decoder)
+    {
+        std::vector<size_t> sizes;
+        for (size_t offset = 0; offset < stream.size(); offset += chunk)
+        {
+            size_t len = stream.size() - offset < chunk ? stream.size() - offset : chunk;
+            decoder.feed(stream.data() + offset, len, [&](const FrameView &frame)
+                         { sizes.push_back(frame.payload_size); });
+        }
+        return sizes;
+    }
+} // namespace
+
+TEST(StreamDecoder, ChunkingDoesNotChangeResult)
+{
+    auto stream = make_stream(200, true);
+    StreamDecoder whole;
+    auto expected = decode_in_chunks(stream, stream.size(), whole);
+    ASSERT_EQ(expected.size(), 200u);
+
+    for (size_t chunk : {1u, 2u, 3u, 7u, 64u, 261u, 1000u})
+    {
+        StreamDecoder decoder;
+        EXPECT_EQ(decode_in_chunks(stream, chunk, decoder), expected) << "chunk " << chunk;
+        EXPECT_EQ(decoder.skipped_bytes(), whole.skipped_bytes()) << "chunk " << chunk;
+    }
+}
+
+TEST(StreamDecoder, StraddlingFrameOnlyCarriesItsOwnBytes)
+{
+    auto first = make_frame(config::DATA_TYPE, std::vector<uint8_t>(20, 0x11));
+    auto second = make_frame(config::DATA_TYPE, std::vector<uint8_t>(5, 0x22));
+    std::vector<uint8_t> stream = first;
+    append(stream, second);
+
+    StreamDecoder decoder;
+    size_t frames = decoder.feed(stream.data(), 10, [](const FrameView &) {});
+    EXPECT_EQ(frames, 0u);
+    EXPECT_EQ(decoder.buffered_bytes(), 10u);
+
+    // The rest completes the straddling frame and the next frame is decoded in place: nothing is carried
+    std::vector<const uint8_t *> payloads;
+    frames = decoder.feed(stream.data() + 10, stream.size() - 10, [&](const FrameView &frame)
+                          { payloads.push_back(frame.payload); });
+    ASSERT_EQ(frames, 2u);
+    EXPECT_EQ(decoder.buffered_bytes(), 0u);
+    EXPECT_EQ(payloads[1], stream.data() + first.size() + 4); // zero-copy view into the chunk
+}
+
+TEST(StreamDecoder, CorruptStraddlingFrameResyncs)
+{
+    auto bad = make_frame(config::DATA_TYPE, std::vector<uint8_t>(30, 0x33));
+    bad[10] ^= 0xFF;
+    std::vector<uint8_t> stream = bad;
+    append(stream, make_frame(config::ACK_TYPE));
+
+    StreamDecoder decoder;
+    std::vector<uint8_t> types;
+    decoder.feed(stream.data(), 8, [&](const FrameView &frame)
+                 { types.push_back(frame.type); });
+    decoder.feed(stream.data() + 8, stream.size() - 8, [&](const FrameView &frame)
+                 { types.push_back(frame.type); });
+    ASSERT_EQ(types.size(), 1u);
+    EXPECT_EQ(types[0], config::ACK_TYPE);
+    EXPECT_EQ(decoder.skipped_bytes(), bad.size());
+}
+
+TEST(StreamDecoder, ResetDropsPartialFrame)
+{
+    auto frame = make_frame(config::DATA_TYPE, {1, 2, 3});
+    StreamDecoder decoder;
+    decoder.feed(frame.data(), 4, [](const FrameView &) {});
+    decoder.reset();
+    EXPECT_EQ(decoder.buffered_bytes(), 0u);
+    size_t frames = decoder.feed(frame.data(), frame.size(), [](const FrameView &) {});
+    EXPECT_EQ(frames, 1u);
+}
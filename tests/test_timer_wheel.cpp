@@ -0,0 +1,131 @@
+#include "test_utility.hpp"
+#include "uart_protocol/timer_wheel.hpp"
+
+using namespace uart_protocol;
+
+namespace
+{
+    struct FireLog
+    {
+        TimerWheel *wheel = nullptr;
+        std::vector<uint32_t> fired_at; // Wheel time of each callback
+    };
+
+    void record(TimerNode &, void *context)
+    {
+        auto *log = static_cast<FireLog *>(context);
+        log->fired_at.push_back(log->wheel->now());
+    }
+
+    // Advance one tick at a time, like a periodic caller
+    void step_to(TimerWheel &wheel, uint32_t target)
+    {
+        while (static_cast<int32_t>(target - wheel.now()) > 0)
+        {
+            wheel.advance(wheel.now() + 1);
+        }
+    }
+} // namespace
+
+TEST(TimerWheel, FiresOnItsDeadline)
+{
+    TimerWheel wheel(100);
+    FireLog log{&wheel, {}};
+    TimerNode node;
+    wheel.schedule(node, 10, record, &log);
+    EXPECT_EQ(wheel.remaining(node), 10u);
+
+    EXPECT_EQ(wheel.advance(109), 0u);
+    EXPECT_TRUE(node.armed());
+    EXPECT_EQ(wheel.advance(110), 1u);
+    EXPECT_FALSE(node.armed());
+    EXPECT_EQ(log.fired_at, (std::vector<uint32_t>{110}));
+    EXPECT_EQ(wheel.armed(), 0u);
+}
+
+TEST(TimerWheel, CancelAndReschedule)
+{
+    TimerWheel wheel;
+    FireLog log{&wheel, {}};
+    TimerNode node;
+    wheel.schedule(node, 5, record, &log);
+    EXPECT_TRUE(wheel.cancel(node));
+    EXPECT_FALSE(wheel.cancel(node));
+    wheel.advance(10);
+    EXPECT_TRUE(log.fired_at.empty());
+
+    wheel.schedule(node, 5, record, &log);
+    wheel.schedule(node, 20, record, &log); // Re-arming moves the deadline
+    EXPECT_EQ(wheel.armed(), 1u);
+    wheel.advance(30);
+    EXPECT_EQ(log.fired_at, (std::vector<uint32_t>{30}));
+}
+
+TEST(TimerWheel, LongDelaysCascadeToTheExactTick)
+{
+    // One timer per level boundary and a few odd values in between
+    const uint32_t delays[] = {1, 63, 64, 65, 200, 4095, 4096, 4097, 70000, 262143, 262144, 300001};
+    TimerWheel wheel(7);
+    FireLog log{&wheel, {}};
+    TimerNode nodes[sizeof(delays) / sizeof(delays[0])];
+    for (size_t i = 0; i < sizeof(delays) / sizeof(delays[0]); ++i)
+    {
+        wheel.schedule(nodes[i], delays[i], record, &log);
+    }
+
+    step_to(wheel, 7 + 300001);
+    ASSERT_EQ(log.fired_at.size(), sizeof(delays) / sizeof(delays[0]));
+    for (size_t i = 0; i < sizeof(delays) / sizeof(delays[0]); ++i)
+    {
+        EXPECT_EQ(log.fired_at[i], 7 + delays[i]) << "delay " << delays[i];
+    }
+}
+
+TEST(TimerWheel, BigJumpFiresEverythingDue)
+{
+    TimerWheel wheel;
+    FireLog log{&wheel, {}};
+    TimerNode early, late;
+    wheel.schedule(early, 1000, record, &log);
+    wheel.schedule(late, 100000, record, &log);
+    EXPECT_EQ(wheel.advance(50000), 1u);
+    EXPECT_TRUE(late.armed());
+    EXPECT_EQ(wheel.remaining(late), 50000u);
+}
+
+TEST(TimerWheel, HandlesTickCounterWrap)
+{
+    TimerWheel wheel(UINT32_MAX - 5);
+    FireLog log{&wheel, {}};
+    TimerNode node;
+    wheel.schedule(node, 10, record, &log); // Expires at tick 4 after the wrap
+    step_to(wheel, 3);
+    EXPECT_TRUE(log.fired_at.empty());
+    step_to(wheel, 4);
+    EXPECT_EQ(log.fired_at, (std::vector<uint32_t>{4}));
+}
+
+TEST(TimerWheel, CallbackMayRescheduleItself)
+{
+    struct Periodic
+    {
+        TimerWheel *wheel;
+        size_t count = 0;
+    } periodic{nullptr};
+    TimerWheel wheel;
+    periodic.wheel = &wheel;
+    TimerNode node;
+
+    auto tick = [](TimerNode &self, void *context)
+    {
+        auto *p = static_cast<Periodic *>(context);
+        if (++p->count < 3)
+        {
+            p->wheel->schedule(self, 100, self.callback, context);
+        }
+    };
+    wheel.schedule(node, 100, tick, &periodic);
+    step_to(wheel, 1000);
+    EXPECT_EQ(periodic.count, 3u);
+    EXPECT_FALSE(node.armed());
+}
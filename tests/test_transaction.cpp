@@ -0,0 +1,155 @@
+#include "test_utility.hpp"
+#include "uart_protocol/transaction.hpp"
+#include <thread>
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+
+namespace
+{
+    struct Completion
+    {
+        uint8_t id = 0;
+        TransactionStatus status = TransactionStatus::Cancelled;
+        std::vector<uint8_t> payload;
+        size_t calls = 0;
+    };
+
+    void on_done(void *context, uint8_t id, TransactionStatus status, const uint8_t *payload, size_t len)
+    {
+        auto *completion = static_cast<Completion *>(context);
+        completion->id = id;
+        completion->status = status;
+        completion->payload.assign(payload, payload + len);
+        ++completion->calls;
+    }
+} // namespace
+
+TEST(Transaction, ResponsesCompleteTheirOwnCommand)
+{
+    MockUart uart;
+    Protocol protocol(uart);
+    CommandClient<Uart, 4> client(protocol);
+
+    Completion first, second;
+    const uint8_t command[] = {0x10};
+    uint8_t id1 = client.send_command(command, 1, on_done, &first);
+    uint8_t id2 = client.send_command(command, 1, on_done, &second);
+    ASSERT_NE(id1, 0);
+    ASSERT_NE(id2, 0);
+    ASSERT_NE(id1, id2);
+    EXPECT_EQ(uart.writes[1], make_frame(config::CMD_TYPE, {id2, 0x10}));
+    EXPECT_EQ(client.pending(), 2u);
+
+    // Out of order: the second command is answered first
+    EXPECT_TRUE(client.on_frame(Frame{config::RESP_TYPE, {id2, 0xAB}}));
+    EXPECT_EQ(second.status, TransactionStatus::Completed);
+    EXPECT_EQ(second.payload, (std::vector<uint8_t>{0xAB}));
+    EXPECT_EQ(first.calls, 0u);
+
+    EXPECT_FALSE(client.on_frame(Frame{config::RESP_TYPE, {id2, 0xAB}})); // Duplicate
+    EXPECT_FALSE(client.on_frame(Frame{config::DATA_TYPE, {id1}}));
+    EXPECT_TRUE(client.on_frame(Frame{config::RESP_TYPE, {id1}}));
+    EXPECT_EQ(first.id, id1);
+    EXPECT_EQ(client.pending(), 0u);
+}
+
+TEST(Transaction, FullTableAndFailedSendReturnZero)
+{
+    MockUart uart;
+    Protocol protocol(uart);
+    CommandClient<Uart, 2> client(protocol);
+    Completion done;
+
+    EXPECT_NE(client.send_command(nullptr, 0, on_done, &done), 0);
+    uart.refuse_writes = 1;
+    EXPECT_EQ(client.send_command(nullptr, 0, on_done, &done), 0); // Released again, no callback
+    EXPECT_EQ(done.calls, 0u);
+    EXPECT_NE(client.send_command(nullptr, 0, on_done, &done), 0);
+    EXPECT_EQ(client.send_command(nullptr, 0, on_done, &done), 0); // Full
+    EXPECT_EQ(client.pending(), 2u);
+}
+
+TEST(Transaction, CancelRunsTheCallback)
+{
+    TransactionTable<4> table;
+    Completion done;
+    uint8_t id = table.begin(1000, on_done, &done);
+    EXPECT_TRUE(table.cancel(id));
+    EXPECT_EQ(done.status, TransactionStatus::Cancelled);
+    EXPECT_FALSE(table.cancel(id));
+    EXPECT_FALSE(table.complete(id, nullptr, 0));
+}
+
+TEST(Transaction, PollTimesOutOverdueCommands)
+{
+    TransactionTable<4> table;
+    Completion fast, slow;
+    table.begin(5, on_done, &fast);
+    table.begin(60000, on_done, &slow);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(table.expire(), 1u);
+    EXPECT_EQ(fast.status, TransactionStatus::TimedOut);
+    EXPECT_EQ(slow.calls, 0u);
+    EXPECT_EQ(table.pending(), 1u);
+}
+
+TEST(Transaction, WheelDrivesTheDeadlines)
+{
+    TimerWheel wheel(0);
+    TransactionTable<4> table(&wheel);
+    Completion done, answered;
+    uint8_t late = table.begin(50, on_done, &done);
+    uint8_t id = table.begin(50, on_done, &answered);
+    EXPECT_TRUE(table.complete(id, nullptr, 0)); // Disarms its timer
+
+    EXPECT_EQ(table.expire(), 0u); // No scanning with a wheel
+    wheel.advance(49);
+    EXPECT_EQ(done.calls, 0u);
+    wheel.advance(50);
+    EXPECT_EQ(done.status, TransactionStatus::TimedOut);
+    EXPECT_EQ(done.id, late);
+    EXPECT_EQ(answered.calls, 1u);
+    EXPECT_EQ(wheel.armed(), 0u);
+}
+
+TEST(Transaction, SendResponseEchoesTheId)
+{
+    MockUart uart;
+    Protocol protocol(uart);
+    const uint8_t data[] = {1, 2};
+    ASSERT_TRUE(send_response(protocol, 7, data, sizeof(data)));
+    EXPECT_EQ(uart.writes[0], make_frame(config::RESP_TYPE, {7, 1, 2}));
+    EXPECT_EQ(transaction_id_of(Frame{config::CMD_TYPE, {9, 1}}), 9);
+    EXPECT_EQ(transaction_id_of(Frame{config::CMD_TYPE, {}}), 0);
+}
+
+TEST(Transaction, ResponsesFromReceiveFramesCompleteWithoutAFrameCopy)
+{
+    MockUart uart;
+    Protocol protocol(uart);
+    CommandClient<Uart, 4> client(protocol);
+
+    Completion first, second;
+    const uint8_t command[] = {0x10};
+    uint8_t id1 = client.send_command(command, 1, on_done, &first);
+    uint8_t id2 = client.send_command(command, 1, on_done, &second);
+    append(uart.rx, make_frame(config::RESP_TYPE, {id2, 0xCD}));
+    append(uart.rx, make_frame(config::DATA_TYPE, {id1}));
+    append(uart.rx, make_frame(config::RESP_TYPE, {id1}));
+
+    FrameView frames[4];
+    size_t count = protocol.receive_frames(frames, 4);
+    ASSERT_EQ(count, 3u);
+    EXPECT_EQ(transaction_id_of(frames[0]), id2);
+    size_t completed = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        completed += client.on_frame(frames[i]) ? 1 : 0;
+    }
+    EXPECT_EQ(completed, 2u);
+    EXPECT_EQ(second.payload, (std::vector<uint8_t>{0xCD}));
+    EXPECT_EQ(first.status, TransactionStatus::Completed);
+    EXPECT_EQ(client.pending(), 0u);
+    EXPECT_EQ(transaction_id_of(FrameView{}), 0);
+}
@@ -0,0 +1,109 @@
+#include "test_utility.hpp"
+#include "uart_protocol/tx_coalescer.hpp"
+#include "uart_protocol/protocol.hpp"
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+
+TEST(CoalescingUart, MergesWritesUntilFlush)
+{
+    MockUart uart;
+    CoalescingUart<MockUart, 64> coalescer(uart);
+    coalescer.set_max_delay_us(UINT32_MAX);
+
+    const uint8_t a[] = {1, 2, 3};
+    const uint8_t b[] = {4, 5};
+    EXPECT_TRUE(coalescer.send_data(a, sizeof(a)));
+    EXPECT_TRUE(coalescer.send_data(b, sizeof(b)));
+    EXPECT_TRUE(uart.writes.empty());
+    EXPECT_EQ(coalescer.staged_bytes(), 5u);
+
+    EXPECT_TRUE(coalescer.flush());
+    ASSERT_EQ(uart.writes.size(), 1u);
+    EXPECT_EQ(uart.writes[0], (std::vector<uint8_t>{1, 2, 3, 4, 5}));
+    EXPECT_EQ(coalescer.writes_requested(), 2u);
+    EXPECT_EQ(coalescer.writes_issued(), 1u);
+    EXPECT_EQ(coalescer.writes_saved(), 1u);
+}
+
+TEST(CoalescingUart, FlushesAtThresholdAndKeepsOrderForLargeWrites)
+{
+    MockUart uart;
+    CoalescingUart<MockUart, 8> coalescer(uart);
+    coalescer.set_max_delay_us(UINT32_MAX);
+    coalescer.set_flush_threshold(4);
+
+    const uint8_t small[] = {1, 2};
+    coalescer.send_data(small, sizeof(small));
+    EXPECT_TRUE(uart.writes.empty());
+    coalescer.send_data(small, sizeof(small));
+    ASSERT_EQ(uart.writes.size(), 1u);
+
+    const uint8_t tail[] = {3};
+    std::vector<uint8_t> large(20, 0x77);
+    coalescer.send_data(tail, sizeof(tail));
+    coalescer.send_data(large.data(), large.size());
+    ASSERT_EQ(uart.writes.size(), 3u);
+    EXPECT_EQ(uart.writes[1], (std::vector<uint8_t>{3}));
+    EXPECT_EQ(uart.writes[2], large);
+}
+
+TEST(CoalescingUart, ReceiveFlushesStagedBytes)
+{
+    MockUart uart;
+    CoalescingUart<MockUart> coalescer(uart);
+    coalescer.set_max_delay_us(UINT32_MAX);
+    BasicProtocol<CoalescingUart<MockUart>> protocol(coalescer);
+
+    protocol.send_frame(config::DATA_TYPE, {1});
+    EXPECT_TRUE(uart.writes.empty());
+    FrameView frames[1];
+    protocol.receive_frames(frames, 1);
+    ASSERT_EQ(uart.writes.size(), 1u);
+    EXPECT_EQ(uart.writes[0], make_frame(config::DATA_TYPE, {1}));
+}
+
+TEST(CoalescingUart, RefusedWritesAreFailuresNotSavings)
+{
+    MockUart uart;
+    CoalescingUart<MockUart, 64> coalescer(uart);
+    coalescer.set_max_delay_us(UINT32_MAX);
+
+    const uint8_t a[] = {1};
+    coalescer.send_data(a, sizeof(a));
+    uart.refuse_writes = 1;
+    EXPECT_FALSE(coalescer.flush());
+    EXPECT_EQ(coalescer.staged_bytes(), 1u);
+    EXPECT_EQ(coalescer.write_failures(), 1u);
+    EXPECT_EQ(coalescer.writes_issued(), 0u);
+    EXPECT_EQ(coalescer.writes_saved(), 0u);
+
+    EXPECT_TRUE(coalescer.flush());
+    EXPECT_EQ(coalescer.writes_issued(), 1u);
+}
+
+TEST(CoalescingUart, StagedBytesAreAcceptedWhenTheThresholdFlushFails)
+{
+    MockUart uart;
+    CoalescingUart<MockUart, 8> coalescer(uart);
+    coalescer.set_max_delay_us(UINT32_MAX);
+    coalescer.set_flush_threshold(4);
+
+    const uint8_t a[] = {1, 2, 3, 4};
+    uart.refuse_writes = 1;
+    EXPECT_TRUE(coalescer.send_data(a, sizeof(a))); // Staged: must not be retried by the caller
+    EXPECT_EQ(coalescer.write_failures(), 1u);
+    EXPECT_EQ(coalescer.staged_bytes(), 4u);
+
+    const uint8_t b[] = {5, 6};
+    EXPECT_TRUE(coalescer.send_data(b, sizeof(b))); // Threshold flush retries the staged bytes
+    ASSERT_EQ(uart.writes.size(), 1u);
+    EXPECT_EQ(uart.writes[0], (std::vector<uint8_t>{1, 2, 3, 4, 5, 6}));
+
+    // No room and the staged bytes cannot be flushed: not taken
+    const uint8_t c[] = {7, 8, 9, 10, 11, 12};
+    EXPECT_TRUE(coalescer.send_data(c, 3));
+    uart.refuse_writes = 1;
+    EXPECT_FALSE(coalescer.send_data(c, sizeof(c)));
+    EXPECT_EQ(coalescer.staged_bytes(), 3u);
+}
@@ -0,0 +1,158 @@
+#include "test_utility.hpp"
+#include "uart_protocol/tx_scheduler.hpp"
+#include "uart_protocol/protocol.hpp"
+#include <atomic>
+#include <thread>
+
+using namespace uart_protocol;
+using namespace uart_protocol::test;
+
+TEST(TxScheduler, ClassifiesFrameTypes)
+{
+    EXPECT_EQ(tx_priority_of(config::ACK_TYPE), TxPriority::Control);
+    EXPECT_EQ(tx_priority_of(config::CREDIT_TYPE), TxPriority::Control);
+    EXPECT_EQ(tx_priority_of(config::CMD_TYPE), TxPriority::Command);
+    EXPECT_EQ(tx_priority_of(config::DATA_TYPE), TxPriority::Data);
+    EXPECT_EQ(tx_priority_of(0xEE), TxPriority::Data);
+}
+
+TEST(TxScheduler, DrainsHighestClassFirstAndFifoWithinClass)
+{
+    TxScheduler<> scheduler;
+    const uint8_t one[] = {1};
+    const uint8_t two[] = {2};
+    ASSERT_EQ(scheduler.enqueue(config::DATA_TYPE, one, 1), TxStatus::Queued);
+    ASSERT_EQ(scheduler.enqueue(config::CMD_TYPE, one, 1), TxStatus::Queued);
+    ASSERT_EQ(scheduler.enqueue(config::DATA_TYPE, two, 1), TxStatus::Queued);
+    ASSERT_EQ(scheduler.enqueue(config::ACK_TYPE, nullptr, 0), TxStatus::Queued);
+    EXPECT_EQ(scheduler.pending(), 4u);
+
+    MockUart uart;
+    EXPECT_EQ(scheduler.drain(uart), 4u);
+    EXPECT_EQ(uart.written_types(), (std::vector<uint8_t>{config::ACK_TYPE, config::CMD_TYPE, config::DATA_TYPE, config::DATA_TYPE}));
+    EXPECT_EQ(uart.writes[2], make_frame(config::DATA_TYPE, {1}));
+    EXPECT_EQ(uart.writes[3], make_frame(config::DATA_TYPE, {2}));
+    EXPECT_TRUE(scheduler.empty());
+}
+
+TEST(TxScheduler, FullClassRejectsWithoutBlockingOthers)
+{
+    TxScheduler<2, 2, 2> scheduler;
+    EXPECT_EQ(scheduler.enqueue(config::DATA_TYPE, {1}), TxStatus::Queued);
+    EXPECT_EQ(scheduler.enqueue(config::DATA_TYPE, {2}), TxStatus::Queued);
+    EXPECT_EQ(scheduler.enqueue(config::DATA_TYPE, {3}), TxStatus::QueueFull);
+    EXPECT_EQ(scheduler.rejected(TxPriority::Data), 1u);
+    EXPECT_EQ(scheduler.enqueue(config::ACK_TYPE, {}), TxStatus::Queued);
+    EXPECT_EQ(scheduler.enqueue(config::DATA_TYPE, std::vector<uint8_t>(config::MAX_PAYLOAD_SIZE + 1)), TxStatus::PayloadTooLarge);
+}
+
+TEST(TxScheduler, RefusedFrameStaysQueued)
+{
+    TxScheduler<> scheduler;
+    scheduler.enqueue(config::DATA_TYPE, {1});
+    scheduler.enqueue(config::DATA_TYPE, {2});
+
+    MockUart uart;
+    uart.refuse_writes = 1;
+    EXPECT_EQ(scheduler.drain(uart), 0u);
+    EXPECT_EQ(scheduler.pending(), 2u);
+    EXPECT_EQ(scheduler.drain(uart, 1), 1u);
+    EXPECT_EQ(uart.writes[0], make_frame(config::DATA_TYPE, {1}));
+}
+
+TEST(TxScheduler, EnqueueEncodedClassesByTypeByte)
+{
+    TxScheduler<> scheduler;
+    auto data = make_frame(config::DATA_TYPE, {9});
+    auto ack = make_frame(config::ACK_TYPE);
+    const uint8_t raw[] = {0x01, 0x02};
+    EXPECT_EQ(scheduler.enqueue_encoded(data.data(), data.size()), TxStatus::Queued);
+    EXPECT_EQ(scheduler.enqueue_encoded(raw, sizeof(raw)), TxStatus::Queued);
+    EXPECT_EQ(scheduler.enqueue_encoded(ack.data(), ack.size()), TxStatus::Queued);
+    EXPECT_EQ(scheduler.pending(TxPriority::Control), 1u);
+    EXPECT_EQ(scheduler.pending(TxPriority::Data), 2u);
+
+    MockUart uart;
+    scheduler.drain(uart);
+    ASSERT_EQ(uart.writes.size(), 3u);
+    EXPECT_EQ(uart.writes[0], ack);
+    EXPECT_EQ(uart.writes[1], data);
+    EXPECT_EQ(uart.writes[2], std::vector<uint8_t>(raw, raw + sizeof(raw)));
+}
+
+TEST(ScheduledUart, ProtocolSendsGoThroughTheScheduler)
+{
+    MockUart uart;
+    ScheduledUart<MockUart> scheduled(uart);
+    BasicProtocol<ScheduledUart<MockUart>> protocol(scheduled);
+
+    protocol.send_frame(config::DATA_TYPE, {1});
+    protocol.send_frame(config::DATA_TYPE, {2});
+    protocol.send_ack();
+    EXPECT_TRUE(uart.writes.empty());
+    EXPECT_EQ(scheduled.scheduler().pending(), 3u);
+
+    EXPECT_EQ(scheduled.drain(), 3u);
+    EXPECT_EQ(uart.written_types(), (std::vector<uint8_t>{config::ACK_TYPE, config::DATA_TYPE, config::DATA_TYPE}));
+}
+
+TEST(ScheduledUart, ReceiveDrainsQueuedFramesFirst)
+{
+    MockUart uart;
+    ScheduledUart<MockUart> scheduled(uart);
+    BasicProtocol<ScheduledUart<MockUart>> protocol(scheduled);
+
+    protocol.send_frame(config::CMD_TYPE, {5});
+    FrameView frames[2];
+    EXPECT_EQ(protocol.receive_frames(frames, 2), 0u);
+    EXPECT_EQ(uart.written_types(), (std::vector<uint8_t>{config::CMD_TYPE}));
+    EXPECT_TRUE(scheduled.scheduler().empty());
+}
+
+TEST(ScheduledUart, RxAndApplicationThreadsSendThroughOneProtocol)
+{
+    // An RX task answering with ACKs and the application sending DATA share one protocol; one TX loop drains
+    constexpr uint16_t FRAMES = 3000;
+    MockUart uart;
+    ScheduledUart<MockUart> tx(uart);
+    BasicProtocol<ScheduledUart<MockUart>> protocol(tx);
+    std::atomic<int> running{2};
+
+    auto producer = [&](uint8_t type)
+    {
+        for (uint16_t i = 0; i < FRAMES; ++i)
+        {
+            const uint8_t payload[] = {static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8)};
+            while (!protocol.send_frame(type, payload, sizeof(payload)))
+            {
+                std::this_thread::yield(); // Class full: wait for the TX loop
+            }
+        }
+        running.fetch_sub(1);
+    };
+    std::thread rx_task(producer, config::ACK_TYPE);
+    std::thread app(producer, config::DATA_TYPE);
+    while (running.load() > 0 || !tx.scheduler().empty())
+    {
+        if (tx.drain() == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    rx_task.join();
+    app.join();
+
+    // Every write is one whole frame, and each producer's frames keep their order
+    uint16_t next_ack = 0;
+    uint16_t next_data = 0;
+    for (const auto &write : uart.writes)
+    {
+        FrameView frame;
+        size_t consumed = 0;
+        ASSERT_EQ(decode_frame(write.data(), write.size(), frame, consumed), ParseStatus::Ok);
+        uint16_t index = static_cast<uint16_t>(frame.payload[0] | (frame.payload[1] << 8));
+        EXPECT_EQ(index, frame.type == config::ACK_TYPE ? next_ack++ : next_data++);
+    }
+    EXPECT_EQ(next_ack, FRAMES);
+    EXPECT_EQ(next_data, FRAMES);
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include "uart_protocol/peripheral.hpp"
+#include "uart_protocol/ProtocolConfig.hpp"
+#include "uart_protocol/frame_utility.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/*
+ * Test Utility - Helpers shared by the unit tests.
+ *
+ * make_frame() encodes a frame into a byte vector, MockUart records every driver write and hands
+ * out scripted RX bytes in chunks of a configurable size. temp_path()/read_file()/write_file() back
+ * the tests of the on-disk formats (capture files, frame index).
+ */
+
+namespace uart_protocol::test
+{
+    inline std::vector<uint8_t> make_frame(uint8_t type, const std::vector<uint8_t> &payload = {})
+    {
+        uint8_t raw[MAX_FRAME_SIZE];
+        size_t size = encode_frame(type, payload.data(), payload.size(), raw);
+        return std::vector<uint8_t>(raw, raw + size);
+    }
+
+    inline void append(std::vector<uint8_t> &stream, const std::vector<uint8_t> &bytes)
+    {
+        stream.insert(stream.end(), bytes.begin(), bytes.end());
+    }
+
+    inline std::string temp_path(const char *name)
+    {
+        return ::testing::TempDir() + name;
+    }
+
+    inline std::vector<uint8_t> read_file(const std::string &path)
+    {
+        std::vector<uint8_t> bytes;
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (file != nullptr)
+        {
+            uint8_t chunk[4096];
+            size_t n;
+            while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+            {
+                bytes.insert(bytes.end(), chunk, chunk + n);
+            }
+            std::fclose(file);
+        }
+        return bytes;
+    }
+
+    inline bool write_file(const std::string &path, const std::vector<uint8_t> &bytes)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+        bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+        return std::fclose(file) == 0 && ok;
+    }
+
+    class MockUart : public Uart
+    {
+    public:
+        std::vector<std::vector<uint8_t>> writes; // One entry per accepted send_data() call
+        std::vector<uint8_t> rx;                  // Bytes still to be received
+        size_t chunk_size = SIZE_MAX;             // Max bytes per receive_data() call
+        size_t refuse_writes = 0;                 // Number of upcoming send_data() calls to refuse
+        size_t receive_calls = 0;
+
+        bool init() override { return true; }
+        void deinit() override {}
+
+        bool send_data(const uint8_t *data, size_t size) override
+        {
+            if (refuse_writes > 0)
+            {
+                --refuse_writes;
+                return false;
+            }
+            writes.emplace_back(data, data + size);
+            return true;
+        }
+
+        size_t receive_data(uint8_t *out_buffer, size_t max_bytes) override
+        {
+            ++receive_calls;
+            size_t n = rx.size() < max_bytes ? rx.size() : max_bytes;
+            n = n < chunk_size ? n : chunk_size;
+            std::memcpy(out_buffer, rx.data(), n);
+            rx.erase(rx.begin(), rx.begin() + static_cast<std::ptrdiff_t>(n));
+            return n;
+        }
+
+        // Frame types of all writes, in order
+        std::vector<uint8_t> written_types() const
+        {
+            std::vector<uint8_t> types;
+            for (const auto &write : writes)
+            {
+                types.push_back(write.size() > 3 ? write[3] : 0);
+            }
+            return types;
+        }
+    };
+} // namespace uart_protocol::test